@@ -0,0 +1,83 @@
+#include "bandit.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sudoku.h"
+#include "rng.h"
+
+
+// === ADAPTIVE OPERATOR SELECTION (DISCOUNTED UCB) ===
+
+void initBandit(OperatorBandit* bandit, int armCount) {
+    memset(bandit, 0, sizeof(OperatorBandit));
+    bandit->armCount = armCount < MAX_BANDIT_ARMS ? armCount : MAX_BANDIT_ARMS;
+}
+
+// Fitness gain per CPU second observed for an arm
+static double gainRate(OperatorBandit* bandit, int arm) {
+    return bandit->gain[arm] / (bandit->seconds[arm] + 1e-9);
+}
+
+// Pick the arm with the best upper confidence bound on its gain rate
+int selectArm(OperatorBandit* bandit, RandomState* random) {
+    // Every arm is tried once first, in random order
+    int untried[MAX_BANDIT_ARMS];
+    int untriedCount = 0;
+    for(int arm = 0; arm < bandit->armCount; arm++) {
+        if(bandit->uses[arm] == 0) untried[untriedCount++] = arm;
+    }
+    if(untriedCount > 0) return untried[randomInt(random, untriedCount)];
+
+    // Rates differ by orders of magnitude between puzzles - normalize to the best arm
+    double bestRate = 0.0;
+    for(int arm = 0; arm < bandit->armCount; arm++) {
+        double rate = gainRate(bandit, arm);
+        if(rate > bestRate) bestRate = rate;
+    }
+
+    double logPulls = log(bandit->totalPulls + 1.0);
+    int bestArm = 0;
+    double bestScore = -1.0;
+    for(int arm = 0; arm < bandit->armCount; arm++) {
+        double exploit = bestRate > 0.0 ? gainRate(bandit, arm) / bestRate : 0.0;
+        double explore = BANDIT_EXPLORATION * sqrt(logPulls / (bandit->pulls[arm] + 1e-9));
+        double score = exploit + explore;
+        if(score > bestScore) {
+            bestScore = score;
+            bestArm = arm;
+        }
+    }
+
+    return bestArm;
+}
+
+// Whether to time this pull of an arm. A CPU clock read costs about as much
+// as an operator, so only the first and then every BANDIT_TIMING_INTERVAL-th
+// pull of each arm is timed.
+int timeArm(OperatorBandit* bandit, int arm) {
+    return bandit->uses[arm] % BANDIT_TIMING_INTERVAL == 0;
+}
+
+// Fold a timed pull into the arm's cost estimate (a moving mean, so it
+// follows operators whose cost changes with the population)
+void recordArmTime(OperatorBandit* bandit, int arm, double seconds) {
+    if(bandit->uses[arm] == 0) bandit->cost[arm] = seconds;
+    else bandit->cost[arm] += 0.25 * (seconds - bandit->cost[arm]);
+}
+
+// Credit an arm with the fitness gain it produced, charged at its estimated
+// CPU cost. Older observations are discounted so the policy follows the
+// search phase.
+void rewardArm(OperatorBandit* bandit, int arm, double gain) {
+    for(int i = 0; i < bandit->armCount; i++) {
+        bandit->pulls[i] *= BANDIT_DISCOUNT;
+        bandit->gain[i] *= BANDIT_DISCOUNT;
+        bandit->seconds[i] *= BANDIT_DISCOUNT;
+    }
+    bandit->totalPulls = bandit->totalPulls * BANDIT_DISCOUNT + 1.0;
+
+    bandit->pulls[arm] += 1.0;
+    bandit->gain[arm] += gain > 0.0 ? gain : 0.0;
+    bandit->seconds[arm] += bandit->cost[arm];
+    bandit->uses[arm]++;
+}
@@ -0,0 +1,13 @@
+#ifndef BANDIT_H
+#define BANDIT_H
+
+#include "sudoku.h"
+
+// Adaptive operator selection
+void initBandit(OperatorBandit* bandit, int armCount);
+int selectArm(OperatorBandit* bandit, RandomState* random);
+int timeArm(OperatorBandit* bandit, int arm);
+void recordArmTime(OperatorBandit* bandit, int arm, double seconds);
+void rewardArm(OperatorBandit* bandit, int arm, double gain);
+
+#endif
@@ -3,12 +3,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sudoku.h"
+#include "rng.h"
 
 // Helper Functions
 void copyBoard(SudokuBoard* source, SudokuBoard* destination) {
     memcpy(destination->board, source->board, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
     memcpy(destination->initial, source->initial, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
     destination->fitness = source->fitness;
+    memcpy(destination->unitDigits, source->unitDigits, sizeof(destination->unitDigits));
+    destination->index = source->index;
 }
 
 int isFixed(SudokuBoard* board, int row, int col) {
@@ -18,6 +21,7 @@ int isFixed(SudokuBoard* board, int row, int col) {
 void setInitialPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE]) {
     memcpy(board->initial, puzzle, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
     memcpy(board->board, puzzle, sizeof(int) * BOARD_SIZE * BOARD_SIZE);
+    board->index = NULL;
 }
 
 int isValidNumber(SudokuBoard* board, int row, int col, int num) {
@@ -45,9 +49,15 @@ int isValidNumber(SudokuBoard* board, int row, int col, int num) {
 }
 
 // Initialize board with random valid numbers
-void initializeBoard(SudokuBoard* board) {
+void initializeBoard(SudokuBoard* board, RandomState* random) {
+    initializeBoardFromPuzzle(board, INITIAL_PUZZLE, random);
+}
+
+// Initialize board for the given puzzle with random valid numbers
+void initializeBoardFromPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                               RandomState* random) {
     // Set initial puzzle
-    setInitialPuzzle(board, INITIAL_PUZZLE);
+    setInitialPuzzle(board, puzzle);
 
     // Fill empty cells with random valid numbers
     for(int row = 0; row < BOARD_SIZE; row++) {
@@ -56,7 +66,7 @@ void initializeBoard(SudokuBoard* board) {
                 int numbers[9] = {1,2,3,4,5,6,7,8,9};
                 // Shuffle numbers
                 for(int i = 8; i > 0; i--) {
-                    int j = rand() % (i + 1);
+                    int j = randomInt(random, i + 1);
                     int temp = numbers[i];
                     numbers[i] = numbers[j];
                     numbers[j] = temp;
@@ -72,7 +82,7 @@ void initializeBoard(SudokuBoard* board) {
 
                 // If no valid number found, just put any number (will be fixed by evolution)
                 if(board->board[row][col] == 0) {
-                    board->board[row][col] = 1 + (rand() % 9);
+                    board->board[row][col] = 1 + randomInt(random, 9);
                 }
             }
         }
@@ -128,46 +138,26 @@ int countConflicts(SudokuBoard* board) {
     return conflicts;
 }
 
+// Fitness = distinct digits per row, column and block (27 units x 9 = 243).
+// The digit counts behind it stay with the board, so single-cell changes
+// can update fitness by the count deltas (see setCell()).
 int calculateFitness(SudokuBoard* board) {
-    int fitness = 0;
+    memset(board->unitDigits, 0, sizeof(board->unitDigits));
 
-    // Check rows (max 9 points per row, total 81 points possible)
     for(int row = 0; row < BOARD_SIZE; row++) {
-        int used[10] = {0};
         for(int col = 0; col < BOARD_SIZE; col++) {
             int num = board->board[row][col];
-            if(num > 0 && used[num] == 0) {
-                used[num] = 1;
-                fitness++;
-            }
+            if(num < 1 || num > 9) continue;
+            board->unitDigits[ROW_UNIT(row)][num]++;
+            board->unitDigits[COLUMN_UNIT(col)][num]++;
+            board->unitDigits[BLOCK_UNIT(row, col)][num]++;
         }
     }
 
-    // Check columns (max 9 points per column, total 81 points possible)
-    for(int col = 0; col < BOARD_SIZE; col++) {
-        int used[10] = {0};
-        for(int row = 0; row < BOARD_SIZE; row++) {
-            int num = board->board[row][col];
-            if(num > 0 && used[num] == 0) {
-                used[num] = 1;
-                fitness++;
-            }
-        }
-    }
-
-    // Check 3x3 blocks (max 9 points per block, total 81 points possible)
-    for(int blockRow = 0; blockRow < 3; blockRow++) {
-        for(int blockCol = 0; blockCol < 3; blockCol++) {
-            int used[10] = {0};
-            for(int i = 0; i < 3; i++) {
-                for(int j = 0; j < 3; j++) {
-                    int num = board->board[blockRow*3 + i][blockCol*3 + j];
-                    if(num > 0 && used[num] == 0) {
-                        used[num] = 1;
-                        fitness++;
-                    }
-                }
-            }
+    int fitness = 0;
+    for(int unit = 0; unit < UNIT_COUNT; unit++) {
+        for(int num = 1; num <= 9; num++) {
+            fitness += board->unitDigits[unit][num] != 0;
         }
     }
 
@@ -175,6 +165,27 @@ int calculateFitness(SudokuBoard* board) {
     return fitness;
 }
 
+// Put num into a cell, updating the digit counts and fitness incrementally:
+// a unit loses a point when a digit's count drops to 0 and gains one when it
+// rises from 0. Requires counts from an earlier calculateFitness().
+void setCell(SudokuBoard* board, int cell, int num) {
+    int row = cell / BOARD_SIZE, col = cell % BOARD_SIZE;
+    int units[3] = {ROW_UNIT(row), COLUMN_UNIT(col), BLOCK_UNIT(row, col)};
+    int old = board->board[row][col];
+
+    if(old >= 1 && old <= 9) {
+        for(int i = 0; i < 3; i++) {
+            board->fitness -= --board->unitDigits[units[i]][old] == 0;
+        }
+    }
+    board->board[row][col] = num;
+    if(num >= 1 && num <= 9) {
+        for(int i = 0; i < 3; i++) {
+            board->fitness += board->unitDigits[units[i]][num]++ == 0;
+        }
+    }
+}
+
 // Check if solution is valid
 int isValidSolution(SudokuBoard* board) {
     return countConflicts(board) == 0;
@@ -5,6 +5,7 @@
 
 // Basic functions for the board
 void copyBoard(SudokuBoard* source, SudokuBoard* destination);
+void setCell(SudokuBoard* board, int cell, int num);
 int isFixed(SudokuBoard* board, int row, int col);
 void setInitialPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE]);
 int isValidNumber(SudokuBoard* board, int row, int col, int num);
@@ -12,7 +13,9 @@ int calculateFitness(SudokuBoard* board);
 int countConflicts(SudokuBoard* board);
 int isValidSolution(SudokuBoard* board);
 void printBoard(SudokuBoard* board);
-void initializeBoard(SudokuBoard* board);
+void initializeBoard(SudokuBoard* board, RandomState* random);
+void initializeBoardFromPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                               RandomState* random);
 
 // Fixed Starting Board
 extern const int INITIAL_PUZZLE[BOARD_SIZE][BOARD_SIZE];
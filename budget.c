@@ -0,0 +1,50 @@
+#include "budget.h"
+#include "sudoku.h"
+#include "timing.h"
+
+static const char* STOP_REASON_NAMES[] = {
+    "running", "solved", "target fitness reached", "generation limit", "stagnation",
+    "time limit", "evaluation limit", "cancelled"
+};
+
+// Start the limits of a solve from its parameters
+void startBudget(SolveBudget* budget, const SolveState* state) {
+    const GAParameters* parameters = state->parameters;
+    budget->start = wallTimeSeconds();
+    budget->deadline = parameters->timeLimit > 0.0 ? budget->start + parameters->timeLimit : 0.0;
+    budget->firstEvaluation = state->evaluations;
+    budget->maxEvaluations = parameters->maxEvaluations;
+    budget->targetFitness = parameters->targetFitness;
+}
+
+// Check every stop condition that can trigger in the middle of a generation;
+// returns STOP_NONE while the solve may go on. Cheap enough to call per child:
+// a few comparisons, an atomic load and, with a deadline set, one clock read.
+StopReason checkBudget(SolveBudget* budget, const SolveState* state, int bestFitness) {
+    if(bestFitness >= 243) return STOP_SOLVED;
+    if(bestFitness >= budget->targetFitness) return STOP_TARGET_REACHED;
+    if(state->progress && atomic_load_explicit(&state->progress->cancelRequested, memory_order_relaxed)) {
+        return STOP_CANCELLED;
+    }
+    if(budget->maxEvaluations > 0 && budgetEvaluations(budget, state) >= budget->maxEvaluations) {
+        return STOP_EVALUATION_LIMIT;
+    }
+    if(budget->deadline > 0.0 && wallTimeSeconds() >= budget->deadline) return STOP_TIME_LIMIT;
+    return STOP_NONE;
+}
+
+// Whether the evaluation limit leaves room for one more evaluation. Checked
+// before every operator, so a child never takes the solve past the limit.
+int evaluationsLeft(SolveBudget* budget, const SolveState* state) {
+    return budget->maxEvaluations <= 0 || budgetEvaluations(budget, state) < budget->maxEvaluations;
+}
+
+// Fitness evaluations since the solve started
+long budgetEvaluations(SolveBudget* budget, const SolveState* state) {
+    return state->evaluations - budget->firstEvaluation;
+}
+
+const char* stopReasonName(StopReason reason) {
+    if(reason < STOP_NONE || reason > STOP_CANCELLED) return "unknown";
+    return STOP_REASON_NAMES[reason];
+}
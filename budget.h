@@ -0,0 +1,13 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include "sudoku.h"
+
+// Solve budgets - wall-clock deadline, evaluation limit and target fitness
+void startBudget(SolveBudget* budget, const SolveState* state);
+StopReason checkBudget(SolveBudget* budget, const SolveState* state, int bestFitness);
+long budgetEvaluations(SolveBudget* budget, const SolveState* state);
+int evaluationsLeft(SolveBudget* budget, const SolveState* state);
+const char* stopReasonName(StopReason reason);
+
+#endif
@@ -1,89 +1,148 @@
 #include "crossover.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "sudoku.h"
+#include "puzzle_index.h"
+#include "rng.h"
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+
+// Bit of each cell within its mask word
+static const unsigned int CELL_BIT[32] = {
+    1u << 0,  1u << 1,  1u << 2,  1u << 3,  1u << 4,  1u << 5,  1u << 6,  1u << 7,
+    1u << 8,  1u << 9,  1u << 10, 1u << 11, 1u << 12, 1u << 13, 1u << 14, 1u << 15,
+    1u << 16, 1u << 17, 1u << 18, 1u << 19, 1u << 20, 1u << 21, 1u << 22, 1u << 23,
+    1u << 24, 1u << 25, 1u << 26, 1u << 27, 1u << 28, 1u << 29, 1u << 30, 1u << 31
+};
 
 
 // === CROSSOVER OPERATORS ===
 
 void crossover(SudokuBoard* parent1, SudokuBoard* parent2,
-              SudokuBoard* child, CrossoverType type) {
+              SudokuBoard* child, CrossoverType type, RandomState* random) {
     switch(type) {
         case SINGLE_POINT:
-            singlePointCrossover(parent1, parent2, child);
+            singlePointCrossover(parent1, parent2, child, random);
             break;
         case MULTI_POINT:
-            multiPointCrossover(parent1, parent2, child);
+            multiPointCrossover(parent1, parent2, child, random);
             break;
         case UNIFORM:
-            uniformCrossover(parent1, parent2, child);
+            uniformCrossover(parent1, parent2, child, random);
+            break;
+        case ROW_CROSSOVER:
+            rowCrossover(parent1, parent2, child, random);
+            break;
+        case BAND_CROSSOVER:
+            bandCrossover(parent1, parent2, child, random);
             break;
         default:
-            singlePointCrossover(parent1, parent2, child);
+            singlePointCrossover(parent1, parent2, child, random);
     }
 }
 
-// Single point crossover - replacement of one 3x3 block
-void singlePointCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
-                         SudokuBoard* child) {
-    copyBoard(parent1, child);
-
-    // Select a random 3x3 block
-    int blockRow = rand() % 3;
-    int blockCol = rand() % 3;
-
-    // Copy block from other parent
-    for(int i = 0; i < BLOCK_SIZE; i++) {
-        for(int j = 0; j < BLOCK_SIZE; j++) {
-            int row = blockRow * BLOCK_SIZE + i;
-            int col = blockCol * BLOCK_SIZE + j;
-            if(!isFixed(child, row, col)) {
-                child->board[row][col] = parent2->board[row][col];
-            }
-        }
+const char* crossoverName(CrossoverType type) {
+    switch(type) {
+        case SINGLE_POINT: return "Single Point";
+        case MULTI_POINT: return "Multi Point";
+        case UNIFORM: return "Uniform";
+        case ROW_CROSSOVER: return "Row";
+        case BAND_CROSSOVER: return "Band";
+        case ADAPTIVE_CROSSOVER: return "Adaptive (bandit)";
+        default: return "Unknown";
     }
+}
 
-    calculateFitness(child);
+// Blend up to 32 cells: second where the mask bit is set, first otherwise.
+// No branch per cell - the compiler turns this into a few vector ops.
+static void blendWord(const int* restrict first, const int* restrict second,
+                      int* restrict out, unsigned int bits, int count) {
+    for(int i = 0; i < count; i++) {
+        int select = -(int)((bits & CELL_BIT[i]) != 0);
+        out[i] = first[i] ^ ((first[i] ^ second[i]) & select);
+    }
 }
 
-// Multi point crossover -replacing multiple 3x3 blocks
-void multiPointCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
-                        SudokuBoard* child) {
-    copyBoard(parent1, child);
-
-    // For each 3x3 block
-    for(int blockRow = 0; blockRow < 3; blockRow++) {
-        for(int blockCol = 0; blockCol < 3; blockCol++) {
-            // 50% chance to replace a block
-            if(rand() % 2 == 0) {
-                for(int i = 0; i < BLOCK_SIZE; i++) {
-                    for(int j = 0; j < BLOCK_SIZE; j++) {
-                        int row = blockRow * BLOCK_SIZE + i;
-                        int col = blockCol * BLOCK_SIZE + j;
-                        if(!isFixed(child, row, col)) {
-                            child->board[row][col] = parent2->board[row][col];
-                        }
-                    }
-                }
-            }
-        }
+// Child = parent1 with the masked cells taken from parent2. Every crossover
+// only builds its mask; the mask is limited to free cells here. The child
+// must not be one of the parents.
+void maskCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   const CellMask* mask) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(parent1, &scratch);
+
+    unsigned int words[MASK_WORDS];
+    for(int w = 0; w < MASK_WORDS; w++) {
+        words[w] = mask->words[w] & index->freeMask.words[w];
     }
 
+    const int* first = &parent1->board[0][0];
+    const int* second = &parent2->board[0][0];
+    int* out = &child->board[0][0];
+
+    // Word lengths kept at multiples of the vector width; the last cell separately
+    blendWord(first, second, out, words[0], 32);
+    blendWord(first + 32, second + 32, out + 32, words[1], 32);
+    blendWord(first + 64, second + 64, out + 64, words[2], 16);
+    int select = -(int)((words[2] >> 16) & 1u);
+    out[CELL_COUNT - 1] = first[CELL_COUNT - 1] ^
+                          ((first[CELL_COUNT - 1] ^ second[CELL_COUNT - 1]) & select);
+
+    memcpy(child->initial, parent1->initial, sizeof(child->initial));
+    child->index = parent1->index;
     calculateFitness(child);
 }
 
-// Uniform crossover - random selection of parent for each cell
-void uniformCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
-                     SudokuBoard* child) {
-    copyBoard(parent1, child);
-
-    for(int i = 0; i < BOARD_SIZE; i++) {
-        for(int j = 0; j < BOARD_SIZE; j++) {
-            if(!isFixed(child, i, j) && rand() % 2 == 0) {
-                child->board[i][j] = parent2->board[i][j];
-            }
-        }
+// Union of the masks whose bit is set in choice (branch free)
+static CellMask unionOfMasks(const CellMask* masks, int count, unsigned int choice) {
+    CellMask mask = {{0}};
+    for(int i = 0; i < count; i++) {
+        unsigned int take = 0u - ((choice >> i) & 1u);
+        for(int w = 0; w < MASK_WORDS; w++) mask.words[w] |= masks[i].words[w] & take;
     }
+    return mask;
+}
 
-    calculateFitness(child);
+// Single point crossover - replacement of one 3x3 block
+void singlePointCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
+                         SudokuBoard* child, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(parent1, &scratch);
+    maskCrossover(parent1, parent2, child, &index->blockMasks[randomInt(random, BOARD_SIZE)]);
+}
+
+// Multi point crossover - replacing each 3x3 block with a 50% chance
+void multiPointCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
+                        SudokuBoard* child, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(parent1, &scratch);
+    CellMask mask = unionOfMasks(index->blockMasks, BOARD_SIZE, randomWord(random));
+    maskCrossover(parent1, parent2, child, &mask);
+}
+
+// Uniform crossover - random selection of parent for each cell (81 random bits at once)
+void uniformCrossover(SudokuBoard* parent1, SudokuBoard* parent2,
+                     SudokuBoard* child, RandomState* random) {
+    CellMask mask;
+    for(int w = 0; w < MASK_WORDS; w++) mask.words[w] = randomWord(random);
+    maskCrossover(parent1, parent2, child, &mask);
+}
+
+// Row crossover - each row from either parent, so rows stay intact
+void rowCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                  RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(parent1, &scratch);
+    CellMask mask = unionOfMasks(index->rowMasks, BOARD_SIZE, randomWord(random));
+    maskCrossover(parent1, parent2, child, &mask);
+}
+
+// Band crossover - one band of three blocks from the other parent, keeping
+// both its rows and its blocks intact
+void bandCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(parent1, &scratch);
+    maskCrossover(parent1, parent2, child, &index->bandMasks[randomInt(random, BLOCK_SIZE)]);
 }
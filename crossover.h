@@ -5,12 +5,19 @@
 
 // Genetic operators - Crossover
 void crossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-              SudokuBoard* child, CrossoverType type);
+              SudokuBoard* child, CrossoverType type, RandomState* random);
 void singlePointCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                         SudokuBoard* child);
+                         SudokuBoard* child, RandomState* random);
 void multiPointCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                        SudokuBoard* child);
+                        SudokuBoard* child, RandomState* random);
 void uniformCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                     SudokuBoard* child);
+                     SudokuBoard* child, RandomState* random);
+void rowCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                  RandomState* random);
+void bandCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   RandomState* random);
+void maskCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   const CellMask* mask);
+const char* crossoverName(CrossoverType type);
 
 #endif
\ No newline at end of file
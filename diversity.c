@@ -0,0 +1,100 @@
+#include "diversity.h"
+#include <math.h>
+#include <string.h>
+#include "sudoku.h"
+
+
+// === POPULATION DIVERSITY ===
+
+// Start a new set of statistics; fixed cells of the reference board are ignored
+void resetDiversity(PopulationDiversity* diversity, SudokuBoard* reference) {
+    memset(diversity->counts, 0, sizeof(diversity->counts));
+    diversity->size = 0;
+    diversity->freeCells = 0;
+
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            diversity->fixed[row][col] = isFixed(reference, row, col);
+            if(!diversity->fixed[row][col]) diversity->freeCells++;
+        }
+    }
+}
+
+// Account for one more individual - called as boards enter the population,
+// so the statistics never need a separate pass over the whole population
+void addToDiversity(PopulationDiversity* diversity, SudokuBoard* board) {
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int num = board->board[row][col];
+            if(num >= 1 && num <= 9) diversity->counts[row][col][num]++;
+        }
+    }
+    diversity->size++;
+}
+
+// Forget an individual leaving the population (steady-state replacement)
+void removeFromDiversity(PopulationDiversity* diversity, SudokuBoard* board) {
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int num = board->board[row][col];
+            if(num >= 1 && num <= 9) diversity->counts[row][col][num]--;
+        }
+    }
+    diversity->size--;
+}
+
+// Derive entropy and mean pairwise Hamming distance from the value counts
+void computeDiversity(PopulationDiversity* diversity) {
+    diversity->entropy = 0.0;
+    diversity->hamming = 0.0;
+    if(diversity->size < 2 || diversity->freeCells == 0) return;
+
+    double n = diversity->size;
+    double entropySum = 0.0;
+    double hammingSum = 0.0;
+
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            if(diversity->fixed[row][col]) continue;
+
+            double sumSquares = 0.0;
+            for(int num = 1; num <= 9; num++) {
+                int count = diversity->counts[row][col][num];
+                if(count == 0) continue;
+                double p = count / n;
+                entropySum -= p * log(p);
+                sumSquares += (double)count * count;
+            }
+            // Fraction of ordered pairs of individuals that differ in this cell
+            hammingSum += (n * n - sumSquares) / (n * (n - 1));
+        }
+    }
+
+    // Both metrics normalized to 0..1 per free cell
+    diversity->entropy = entropySum / (diversity->freeCells * log(9.0));
+    diversity->hamming = hammingSum / diversity->freeCells;
+}
+
+// Diversity relative to its healthy target, limited to 0..1
+static double diversityLevel(double value, double target) {
+    double level = value / target;
+    if(level > 1.0) level = 1.0;
+    if(level < 0.0) level = 0.0;
+    return level;
+}
+
+// Adapt rates to the current diversity. The configured rates are those of a
+// healthy population; as diversity falls the crossover rate moves towards
+// CROSSOVER_RATE_MIN and the mutation rate towards MUTATION_RATE_MAX.
+// Crossover follows the Hamming distance - recombining pays off while
+// individuals still differ. Mutation follows the value entropy, which also
+// counts rare values, so it rises as soon as values start dying out rather
+// than once every pair looks alike.
+void adaptRates(PopulationDiversity* diversity, const GAParameters* parameters,
+                double* crossoverRate, double* mutationRate) {
+    double spread = diversityLevel(diversity->hamming, DIVERSITY_TARGET);
+    double richness = diversityLevel(diversity->entropy, ENTROPY_TARGET);
+
+    *crossoverRate = CROSSOVER_RATE_MIN + (parameters->crossoverRate - CROSSOVER_RATE_MIN) * spread;
+    *mutationRate = MUTATION_RATE_MAX - (MUTATION_RATE_MAX - parameters->mutationRate) * richness;
+}
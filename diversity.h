@@ -0,0 +1,14 @@
+#ifndef DIVERSITY_H
+#define DIVERSITY_H
+
+#include "sudoku.h"
+
+// Population diversity metrics and adaptive rate control
+void resetDiversity(PopulationDiversity* diversity, SudokuBoard* reference);
+void addToDiversity(PopulationDiversity* diversity, SudokuBoard* board);
+void removeFromDiversity(PopulationDiversity* diversity, SudokuBoard* board);
+void computeDiversity(PopulationDiversity* diversity);
+void adaptRates(PopulationDiversity* diversity, const GAParameters* parameters,
+                double* crossoverRate, double* mutationRate);
+
+#endif
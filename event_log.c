@@ -0,0 +1,203 @@
+#define _POSIX_C_SOURCE 200809L
+#include "event_log.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "sudoku.h"
+#include "timing.h"
+
+typedef struct {
+    EventLevel level;
+    EventKind kind;
+    double time;            // Seconds since the log was created
+    int generation;
+    int fitness;
+    char message[EVENT_MESSAGE_SIZE];
+} SolverEvent;
+
+// Ring buffer slot; sequence tells producers and the consumer whose turn it is
+typedef struct {
+    atomic_size_t sequence;
+    SolverEvent event;
+} EventSlot;
+
+struct EventLog {
+    EventSlot* slots;
+    size_t mask;
+    atomic_size_t enqueuePosition;  // Shared by producers
+    size_t dequeuePosition;         // Owned by the drain thread
+    atomic_long dropped;            // Events lost because the buffer was full
+    atomic_int running;
+    pthread_t thread;
+    FILE* output;
+    EventFormat format;
+    EventLevel minLevel;
+    double startTime;
+};
+
+static const char* LEVEL_NAMES[] = {"debug", "info", "warning"};
+static const char* KIND_NAMES[] = {
+    "start", "generation", "improvement", "stagnation", "solved",
+    "finisher", "operators", "cancelled", "budget", "end"
+};
+
+// Take the next event (drain thread only); returns 0 if the buffer is empty
+static int takeEvent(EventLog* log, SolverEvent* event) {
+    EventSlot* slot = &log->slots[log->dequeuePosition & log->mask];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    if(sequence != log->dequeuePosition + 1) return 0;
+
+    *event = slot->event;
+    atomic_store_explicit(&slot->sequence, log->dequeuePosition + log->mask + 1,
+                          memory_order_release);
+    log->dequeuePosition++;
+    return 1;
+}
+
+// Write text as a JSON string body
+static void writeJsonString(FILE* output, const char* text) {
+    for(; *text; text++) {
+        if(*text == '"' || *text == '\\') fprintf(output, "\\%c", *text);
+        else if((unsigned char)*text < 0x20) fprintf(output, "\\u%04x", *text);
+        else fputc(*text, output);
+    }
+}
+
+static void writeEvent(EventLog* log, SolverEvent* event) {
+    if(log->format == EVENT_FORMAT_JSON) {
+        fprintf(log->output,
+                "{\"time\":%.6f,\"level\":\"%s\",\"event\":\"%s\",\"generation\":%d,\"fitness\":%d,\"message\":\"",
+                event->time, LEVEL_NAMES[event->level], KIND_NAMES[event->kind],
+                event->generation, event->fitness);
+        writeJsonString(log->output, event->message);
+        fprintf(log->output, "\"}\n");
+    } else {
+        fprintf(log->output, "[%10.4f] %-7s %-11s gen %5d fitness %3d  %s\n",
+                event->time, LEVEL_NAMES[event->level], KIND_NAMES[event->kind],
+                event->generation, event->fitness, event->message);
+    }
+}
+
+// Drain thread - all formatting and I/O happens here, never on the solver thread
+static void* drainEvents(void* argument) {
+    EventLog* log = (EventLog*)argument;
+    struct timespec pause = {0, EVENT_DRAIN_INTERVAL_MS * 1000000L};
+
+    for(;;) {
+        int running = atomic_load_explicit(&log->running, memory_order_acquire);
+
+        SolverEvent event;
+        int written = 0;
+        while(takeEvent(log, &event)) {
+            writeEvent(log, &event);
+            written++;
+        }
+        if(written > 0) fflush(log->output);
+
+        if(!running) break;  // Stopped, and everything posted before has been written
+        nanosleep(&pause, NULL);
+    }
+
+    return NULL;
+}
+
+
+// === EVENT LOG ===
+
+// Create a log writing to output from its own thread; returns NULL on failure
+EventLog* createEventLog(FILE* output, EventFormat format, EventLevel minLevel) {
+    EventLog* log = (EventLog*)calloc(1, sizeof(EventLog));
+    if(!log) return NULL;
+
+    log->slots = (EventSlot*)calloc(EVENT_QUEUE_CAPACITY, sizeof(EventSlot));
+    if(!log->slots) {
+        free(log);
+        return NULL;
+    }
+
+    log->mask = EVENT_QUEUE_CAPACITY - 1;
+    for(size_t i = 0; i < EVENT_QUEUE_CAPACITY; i++) {
+        atomic_init(&log->slots[i].sequence, i);
+    }
+    atomic_init(&log->enqueuePosition, 0);
+    atomic_init(&log->dropped, 0);
+    atomic_init(&log->running, 1);
+    log->output = output;
+    log->format = format;
+    log->minLevel = minLevel;
+    log->startTime = wallTimeSeconds();
+
+    if(pthread_create(&log->thread, NULL, drainEvents, log) != 0) {
+        free(log->slots);
+        free(log);
+        return NULL;
+    }
+
+    return log;
+}
+
+// Stop the drain thread after it has written all posted events
+void destroyEventLog(EventLog* log) {
+    if(!log) return;
+
+    atomic_store_explicit(&log->running, 0, memory_order_release);
+    pthread_join(log->thread, NULL);
+    free(log->slots);
+    free(log);
+}
+
+// Post an event without blocking - lock-free, safe from several threads.
+// If the buffer is full the event is dropped and counted.
+void postEvent(EventLog* log, EventLevel level, EventKind kind,
+               int generation, int fitness, const char* message) {
+    if(!log || level < log->minLevel) return;
+
+    size_t position = atomic_load_explicit(&log->enqueuePosition, memory_order_relaxed);
+    EventSlot* slot;
+    for(;;) {
+        slot = &log->slots[position & log->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if(difference == 0) {
+            if(atomic_compare_exchange_weak_explicit(&log->enqueuePosition, &position, position + 1,
+                                                     memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if(difference < 0) {
+            atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            position = atomic_load_explicit(&log->enqueuePosition, memory_order_relaxed);
+        }
+    }
+
+    slot->event.level = level;
+    slot->event.kind = kind;
+    slot->event.time = wallTimeSeconds() - log->startTime;
+    slot->event.generation = generation;
+    slot->event.fitness = fitness;
+    if(message) {
+        strncpy(slot->event.message, message, EVENT_MESSAGE_SIZE - 1);
+        slot->event.message[EVENT_MESSAGE_SIZE - 1] = 0;
+    } else {
+        slot->event.message[0] = 0;
+    }
+
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+}
+
+long droppedEvents(EventLog* log) {
+    return log ? atomic_load_explicit(&log->dropped, memory_order_relaxed) : 0;
+}
+
+// Report an event of a running solve to its log and its callback
+void solverEvent(const SolveState* state, EventLevel level, EventKind kind,
+                 int generation, int fitness, const char* message) {
+    postEvent(state->log, level, kind, generation, fitness, message);
+    if(state->callback) state->callback(state->callbackData, level, kind, generation, fitness, message);
+}
@@ -0,0 +1,15 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "sudoku.h"
+
+// Asynchronous event log
+EventLog* createEventLog(FILE* output, EventFormat format, EventLevel minLevel);
+void destroyEventLog(EventLog* log);
+void postEvent(EventLog* log, EventLevel level, EventKind kind,
+               int generation, int fitness, const char* message);
+long droppedEvents(EventLog* log);
+void solverEvent(const SolveState* state, EventLevel level, EventKind kind,
+                 int generation, int fitness, const char* message);
+
+#endif
@@ -1,61 +1,286 @@
 #include "evolution.h"
 #include <stdio.h>
-#include <stdlib.h>
 #include "sudoku.h"
+#include "event_log.h"
+#include "steady_state.h"
+#include "budget.h"
+#include "rng.h"
 
 
+// Report how often the bandit chose each operator
+static void reportOperatorUsage(SolveState* state, OperatorBandit* bandit, int generation, int fitness,
+                                const char* label, const char* (*name)(int)) {
+    char message[EVENT_MESSAGE_SIZE];
+    int length = snprintf(message, sizeof(message), "%s usage:", label);
+    for(int arm = 0; arm < bandit->armCount && length < (int)sizeof(message); arm++) {
+        length += snprintf(message + length, sizeof(message) - length,
+                           " %s (%ld)", name(arm), bandit->uses[arm]);
+    }
+    solverEvent(state, EVENT_INFO, EVENT_OPERATORS, generation, fitness, message);
+}
+
+static const char* crossoverArmName(int arm) {
+    return crossoverName((CrossoverType)arm);
+}
+
+static const char* mutationArmName(int arm) {
+    return mutationName((MutationType)arm);
+}
+
+// Set up rates and operator bandits shared by both evolution engines
+void initBreeding(SolveState* state, BreedingState* breeding) {
+    breeding->crossoverRate = state->parameters->crossoverRate;
+    breeding->mutationRate = state->parameters->mutationRate;
+    initBandit(&breeding->crossoverBandit, ADAPTIVE_CROSSOVER);
+    initBandit(&breeding->mutationBandit, ADAPTIVE_MUTATION);
+}
+
+// Create one child: copy of parent1, crossover and mutation with the current
+// rates. Adaptive operator types are resolved by the bandits. Every operator
+// applied counts as one fitness evaluation of the solve; an operator the
+// evaluation limit has no room for is skipped.
+void breedChild(SolveState* state, SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                CrossoverType crossType, MutationType mutType, BreedingState* breeding,
+                SolveBudget* budget) {
+    // First we copy the first parent
+    copyBoard(parent1, child);
+
+    // Crossover with a certain probability
+    if(randomUnit(state->random) < breeding->crossoverRate && evaluationsLeft(budget, state)) {
+        if(crossType == ADAPTIVE_CROSSOVER) {
+            // Credit: improvement over the better parent per CPU second (sampled)
+            OperatorBandit* bandit = &breeding->crossoverBandit;
+            int arm = selectArm(bandit, state->random);
+            int baseline = parent1->fitness > parent2->fitness ?
+                           parent1->fitness : parent2->fitness;
+            int timed = timeArm(bandit, arm);
+            double start = timed ? cpuTimeSeconds() : 0.0;
+            crossover(parent1, parent2, child, (CrossoverType)arm, state->random);
+            if(timed) recordArmTime(bandit, arm, cpuTimeSeconds() - start);
+            rewardArm(bandit, arm, child->fitness - baseline);
+        } else {
+            crossover(parent1, parent2, child, crossType, state->random);
+        }
+        state->evaluations++;
+    }
+
+    // Mutation with a specific probability
+    if(randomUnit(state->random) < breeding->mutationRate && evaluationsLeft(budget, state)) {
+        if(mutType == ADAPTIVE_MUTATION) {
+            OperatorBandit* bandit = &breeding->mutationBandit;
+            int arm = selectArm(bandit, state->random);
+            int baseline = child->fitness;
+            int timed = timeArm(bandit, arm);
+            double start = timed ? cpuTimeSeconds() : 0.0;
+            mutate(child, (MutationType)arm, state->random);
+            if(timed) recordArmTime(bandit, arm, cpuTimeSeconds() - start);
+            rewardArm(bandit, arm, child->fitness - baseline);
+        } else {
+            mutate(child, mutType, state->random);
+        }
+        state->evaluations++;
+    }
+}
+
+// Publish the start of a run
+void reportEvolutionStart(SolveState* state, int fitness) {
+    if(state->progress) {
+        atomic_store_explicit(&state->progress->generation, 0, memory_order_relaxed);
+        atomic_store_explicit(&state->progress->bestFitness, fitness, memory_order_relaxed);
+        atomic_store_explicit(&state->progress->improvements, 0, memory_order_relaxed);
+    }
+    if(state->parameters->verbose) {
+        solverEvent(state, EVENT_INFO, EVENT_START, 0, fitness, "Starting evolution");
+    }
+}
+
+// Publish a new best individual
+void reportImprovement(SolveState* state, int generation, int improvements, int fitness,
+                       PopulationDiversity* diversity, BreedingState* breeding) {
+    if(state->progress) {
+        atomic_store_explicit(&state->progress->bestFitness, fitness, memory_order_relaxed);
+        atomic_store_explicit(&state->progress->improvements, improvements, memory_order_relaxed);
+    }
+    if(state->parameters->verbose) {
+        char message[EVENT_MESSAGE_SIZE];
+        snprintf(message, sizeof(message),
+                 "Improvement %d | Diversity: entropy %.3f, Hamming %.3f | Crossover rate %.2f, Mutation rate %.2f",
+                 improvements, diversity->entropy, diversity->hamming,
+                 breeding->crossoverRate, breeding->mutationRate);
+        solverEvent(state, EVENT_INFO, EVENT_IMPROVEMENT, generation, fitness, message);
+    }
+}
+
+// Common end of both engines: final events, the hybrid finisher and the result
+SolveResult finishEvolution(SolveState* state, SudokuBoard* best, int generation, StopReason reason,
+                            SolveBudget* budget, CrossoverType crossType, MutationType mutType,
+                            BreedingState* breeding) {
+    const GAParameters* parameters = state->parameters;
+    int verbose = parameters->verbose;
+    char message[EVENT_MESSAGE_SIZE];
+
+    if(verbose) {
+        switch(reason) {
+            case STOP_STAGNATION:
+                snprintf(message, sizeof(message), "No improvement for %d generations",
+                         parameters->stagnationLimit);
+                solverEvent(state, EVENT_WARNING, EVENT_STAGNATION, generation, best->fitness, message);
+                break;
+            case STOP_SOLVED:
+                solverEvent(state, EVENT_INFO, EVENT_SOLVED, generation, best->fitness, "Perfect solution found");
+                break;
+            case STOP_CANCELLED:
+                solverEvent(state, EVENT_WARNING, EVENT_CANCELLED, generation, best->fitness, "Cancelled");
+                break;
+            case STOP_TARGET_REACHED:
+            case STOP_TIME_LIMIT:
+            case STOP_EVALUATION_LIMIT:
+                snprintf(message, sizeof(message), "Stopped: %s after %ld evaluations",
+                         stopReasonName(reason), budgetEvaluations(budget, state));
+                solverEvent(state, EVENT_INFO, EVENT_BUDGET, generation, best->fitness, message);
+                break;
+            default:
+                break;
+        }
+        if(crossType == ADAPTIVE_CROSSOVER) {
+            reportOperatorUsage(state, &breeding->crossoverBandit, generation, best->fitness, "Crossover", crossoverArmName);
+        }
+        if(mutType == ADAPTIVE_MUTATION) {
+            reportOperatorUsage(state, &breeding->mutationBandit, generation, best->fitness, "Mutation", mutationArmName);
+        }
+    }
+
+    // Hybrid finisher - complete the best individual exactly when the GA gave
+    // up or ran out of time or evaluations, so a budget bounds the latency of
+    // a solve rather than leaving it unsolved; a target fitness reached or a
+    // cancel request return the best board as it is
+    if(parameters->hybridFinisher &&
+       (reason == STOP_STAGNATION || reason == STOP_MAX_GENERATIONS ||
+        reason == STOP_TIME_LIMIT || reason == STOP_EVALUATION_LIMIT)) {
+        int gaFitness = best->fitness;
+        int finished = finishBoard(best);
+        if(verbose) {
+            snprintf(message, sizeof(message),
+                     finished ? "Exact finisher completed the board (GA reached %d/243)"
+                              : "Exact finisher failed - the puzzle has no solution (GA reached %d/243)",
+                     gaFitness);
+            solverEvent(state, finished ? EVENT_INFO : EVENT_WARNING, EVENT_FINISHER,
+                      generation, best->fitness, message);
+        }
+    }
+
+    if(verbose) solverEvent(state, EVENT_INFO, EVENT_END, generation, best->fitness, NULL);
+    if(state->progress) atomic_store_explicit(&state->progress->bestFitness, best->fitness, memory_order_relaxed);
+
+    SolveResult result;
+    result.best = *best;
+    result.reason = reason;
+    result.generations = generation;
+    result.evaluations = budgetEvaluations(budget, state);
+    result.seconds = wallTimeSeconds() - budget->start;
+    return result;
+}
+
 // Main evolution function
-SudokuBoard evolve(Population* population,
-                  SelectionType selType,
-                  CrossoverType crossType,
-                  MutationType mutType) {
+SolveResult evolve(SolveState* state, Population* population,
+                   SelectionType selType,
+                   CrossoverType crossType,
+                   MutationType mutType) {
+    const GAParameters* parameters = state->parameters;
+    if(parameters->evolutionMode == STEADY_STATE) {
+        return evolveSteadyState(state, population, selType, crossType, mutType);
+    }
+
+    SolveBudget budget;
+    startBudget(&budget, state);
+
     SudokuBoard bestEver = population->boards[0];
     int generationsWithoutImprovement = 0;
     int totalImprovements = 0;
 
-    printf("\nStarting evolution...\n");
-    printf("Initial fitness: %d/243 (%.1f%%)\n",
-           bestEver.fitness, (bestEver.fitness * 100.0) / 243.0);
+    // The population may be smaller than the parameters it is evolved with
+    int eliteCount = parameters->eliteCount;
+    if(eliteCount > population->size - 1) eliteCount = population->size - 1;
+    if(eliteCount < 0) eliteCount = 0;
+
+    BreedingState breeding;
+    initBreeding(state, &breeding);
+
+    // Diversity of the current and of the generation being built
+    PopulationDiversity* diversity = population->diversity;
+    PopulationDiversity* nextDiversity = population->nextDiversity;
+    resetDiversity(diversity, &population->boards[0]);
+    for(int i = 0; i < population->size; i++) {
+        addToDiversity(diversity, &population->boards[i]);
+    }
+    computeDiversity(diversity);
+    if(parameters->adaptiveRates) adaptRates(diversity, parameters, &breeding.crossoverRate, &breeding.mutationRate);
+
+    // Progress is published for the front end, events go to the asynchronous log
+    reportEvolutionStart(state, bestEver.fitness);
+
+    int gen = 0;
+    StopReason reason = checkBudget(&budget, state, bestEver.fitness);
+    while(reason == STOP_NONE) {
+        if(gen >= parameters->maxGenerations) {
+            reason = STOP_MAX_GENERATIONS;
+            break;
+        }
 
-    for(int gen = 0; gen < MAX_GENERATIONS; gen++) {
-        SudokuBoard* newGeneration =
-            (SudokuBoard*)malloc(POPULATION_SIZE * sizeof(SudokuBoard));
+        // Built in the spare buffer - no allocation per generation
+        SudokuBoard* newGeneration = population->spare;
+        resetDiversity(nextDiversity, &population->boards[0]);
 
-        // Elitism
-        for(int i = 0; i < ELITE_COUNT; i++) {
-            int bestIdx = 0;
-            for(int j = 1; j < population->size; j++) {
-                if(population->boards[j].fitness >
-                   population->boards[bestIdx].fitness) {
+        // Elitism (elites are flagged rather than overwritten, so their
+        // fitness stays valid for selection and operator credit)
+        char isElite[MAX_POPULATION_SIZE] = {0};
+        for(int i = 0; i < eliteCount; i++) {
+            int bestIdx = -1;
+            for(int j = 0; j < population->size; j++) {
+                if(!isElite[j] && (bestIdx < 0 ||
+                   population->boards[j].fitness > population->boards[bestIdx].fitness)) {
                     bestIdx = j;
                 }
             }
             copyBoard(&population->boards[bestIdx], &newGeneration[i]);
-            population->boards[bestIdx].fitness = -999999;
+            isElite[bestIdx] = 1;
+            addToDiversity(nextDiversity, &newGeneration[i]);
         }
 
-        // Create new generation
+        // Create new generation; budgets are checked after every child so a
+        // deadline is met within one breeding step
         SudokuBoard bestInGeneration = bestEver;
-        // In the evolve function, in the main 'child' generation loop:
-        for(int i = ELITE_COUNT; i < POPULATION_SIZE; i++) {
-            SudokuBoard parent1 = selectParent(population, selType);
-            SudokuBoard parent2 = selectParent(population, selType);
+        for(int i = eliteCount; i < population->size; i++) {
+            SudokuBoard parent1 = selectParent(population, selType, parameters->tournamentSize, state->random);
+            SudokuBoard parent2 = selectParent(population, selType, parameters->tournamentSize, state->random);
 
-            // First we copy the first parent
-            copyBoard(&parent1, &newGeneration[i]);
+            breedChild(state, &parent1, &parent2, &newGeneration[i], crossType, mutType, &breeding, &budget);
 
-            // Crossover with a certain probability
-            if((double)rand() / RAND_MAX < CROSSOVER_RATE) {
-                crossover(&parent1, &parent2, &newGeneration[i], crossType);
+            if(newGeneration[i].fitness > bestInGeneration.fitness) {
+                copyBoard(&newGeneration[i], &bestInGeneration);
             }
+            addToDiversity(nextDiversity, &newGeneration[i]);
 
-            // Mutation with a specific probability
-            if((double)rand() / RAND_MAX < MUTATION_RATE) {
-                mutate(&newGeneration[i], mutType);
-            }
+            reason = checkBudget(&budget, state, bestInGeneration.fitness);
+            if(reason != STOP_NONE) break;
+        }
 
-            if(newGeneration[i].fitness > bestInGeneration.fitness) {
-                copyBoard(&newGeneration[i], &bestInGeneration);
+        // Only a complete generation replaces the population; one stopped
+        // part way is left unused in the spare buffer
+        if(reason == STOP_NONE) {
+            // Statistics of the new generation drive the rates of the next one
+            PopulationDiversity* swap = diversity;
+            diversity = nextDiversity;
+            nextDiversity = swap;
+            computeDiversity(diversity);
+            if(parameters->adaptiveRates) adaptRates(diversity, parameters, &breeding.crossoverRate, &breeding.mutationRate);
+
+            population->spare = population->boards;
+            population->boards = newGeneration;
+            gen++;
+            if(state->progress) atomic_store_explicit(&state->progress->generation, gen, memory_order_relaxed);
+            if(parameters->verbose) {
+                solverEvent(state, EVENT_DEBUG, EVENT_GENERATION, gen - 1, bestInGeneration.fitness, NULL);
             }
         }
 
@@ -63,29 +288,13 @@ SudokuBoard evolve(Population* population,
         if(bestInGeneration.fitness > bestEver.fitness) {
             copyBoard(&bestInGeneration, &bestEver);
             totalImprovements++;
-            printf("\nImprovement %d (Generation %d): Fitness improved to %d/243 (%.1f%%)\n",
-                   totalImprovements, gen, bestEver.fitness,
-                   (bestEver.fitness * 100.0) / 243.0);
-
-            if(bestEver.fitness >= 243) {
-                printf("\nPerfect solution found!\n");
-                free(population->boards);
-                population->boards = newGeneration;
-                return bestEver;
-            }
+            reportImprovement(state, gen, totalImprovements, bestEver.fitness, diversity, &breeding);
             generationsWithoutImprovement = 0;
-        } else {
-            generationsWithoutImprovement++;
-            if(generationsWithoutImprovement >= 300) {
-                printf("\nNo improvement for 300 generations.\n");
-                printf("Consider trying different genetic operators.\n");
-                break;
-            }
+        } else if(reason == STOP_NONE &&
+                  ++generationsWithoutImprovement >= parameters->stagnationLimit) {
+            reason = STOP_STAGNATION;
         }
-
-        free(population->boards);
-        population->boards = newGeneration;
     }
 
-    return bestEver;
+    return finishEvolution(state, &bestEver, gen, reason, &budget, crossType, mutType, &breeding);
 }
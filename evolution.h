@@ -3,9 +3,21 @@
 
 #include "sudoku.h"
 
-SudokuBoard evolve(Population* population, 
-                  SelectionType selType,
-                  CrossoverType crossType,
-                  MutationType mutType);
+SolveResult evolve(SolveState* state, Population* population,
+                   SelectionType selType,
+                   CrossoverType crossType,
+                   MutationType mutType);
+
+// Breeding and reporting shared with the steady-state engine
+void initBreeding(SolveState* state, BreedingState* breeding);
+void breedChild(SolveState* state, SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                CrossoverType crossType, MutationType mutType, BreedingState* breeding,
+                SolveBudget* budget);
+void reportEvolutionStart(SolveState* state, int fitness);
+void reportImprovement(SolveState* state, int generation, int improvements, int fitness,
+                       PopulationDiversity* diversity, BreedingState* breeding);
+SolveResult finishEvolution(SolveState* state, SudokuBoard* best, int generation, StopReason reason,
+                            SolveBudget* budget, CrossoverType crossType, MutationType mutType,
+                            BreedingState* breeding);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "exact_solver.h"
+#include <string.h>
+#include "sudoku.h"
+
+#define ALL_DIGITS 0x3FE  // Bits 1..9 set - one bit per digit
+
+// State of one exact search (kept on the stack, so the solver is reentrant)
+typedef struct {
+    unsigned rowUsed[BOARD_SIZE];
+    unsigned colUsed[BOARD_SIZE];
+    unsigned blockUsed[BOARD_SIZE];
+    int cells[BOARD_SIZE][BOARD_SIZE];
+    int solution[BOARD_SIZE][BOARD_SIZE];  // First solution found
+    long solutions;                        // Solutions found so far
+    long limit;                            // Stop after this many solutions
+} ExactSearch;
+
+static int bitCount(unsigned value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(value);
+#else
+    int count = 0;
+    for(; value; value &= value - 1) count++;
+    return count;
+#endif
+}
+
+static int lowestDigit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int digit = 0;
+    while(!(mask & (1u << digit))) digit++;
+    return digit;
+#endif
+}
+
+static int blockIndex(int row, int col) {
+    return (row / BLOCK_SIZE) * BLOCK_SIZE + col / BLOCK_SIZE;
+}
+
+static void placeDigit(ExactSearch* search, int row, int col, int num) {
+    unsigned bit = 1u << num;
+    search->cells[row][col] = num;
+    search->rowUsed[row] |= bit;
+    search->colUsed[col] |= bit;
+    search->blockUsed[blockIndex(row, col)] |= bit;
+}
+
+static void removeDigit(ExactSearch* search, int row, int col, int num) {
+    unsigned bit = 1u << num;
+    search->cells[row][col] = 0;
+    search->rowUsed[row] &= ~bit;
+    search->colUsed[col] &= ~bit;
+    search->blockUsed[blockIndex(row, col)] &= ~bit;
+}
+
+// Load the clues; returns 0 if they are out of range or contradict each other
+static int loadPuzzle(ExactSearch* search, const int puzzle[BOARD_SIZE][BOARD_SIZE], long limit) {
+    memset(search, 0, sizeof(ExactSearch));
+    search->limit = limit;
+
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int num = puzzle[row][col];
+            if(num == 0) continue;
+            if(num < 0 || num > 9) return 0;
+
+            unsigned bit = 1u << num;
+            if((search->rowUsed[row] | search->colUsed[col] |
+                search->blockUsed[blockIndex(row, col)]) & bit) return 0;
+            placeDigit(search, row, col, num);
+        }
+    }
+
+    return 1;
+}
+
+// Depth-first search, always branching on the empty cell with the fewest candidates
+static void searchCells(ExactSearch* search) {
+    int bestRow = -1, bestCol = -1;
+    int bestCount = 10;
+    unsigned bestCandidates = 0;
+
+    for(int row = 0; row < BOARD_SIZE && bestCount > 1; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            if(search->cells[row][col] != 0) continue;
+
+            unsigned candidates = ALL_DIGITS & ~(search->rowUsed[row] | search->colUsed[col] |
+                                                 search->blockUsed[blockIndex(row, col)]);
+            int count = bitCount(candidates);
+            if(count == 0) return;  // Dead end
+            if(count < bestCount) {
+                bestCount = count;
+                bestRow = row;
+                bestCol = col;
+                bestCandidates = candidates;
+                if(count == 1) break;
+            }
+        }
+    }
+
+    // No empty cell left - the grid is complete
+    if(bestRow < 0) {
+        if(search->solutions == 0) {
+            memcpy(search->solution, search->cells, sizeof(search->cells));
+        }
+        search->solutions++;
+        return;
+    }
+
+    while(bestCandidates) {
+        int num = lowestDigit(bestCandidates);
+        bestCandidates &= bestCandidates - 1;
+
+        placeDigit(search, bestRow, bestCol, num);
+        searchCells(search);
+        removeDigit(search, bestRow, bestCol, num);
+
+        if(search->solutions >= search->limit) return;
+    }
+}
+
+
+// === EXACT SOLVER ===
+
+// Solve a puzzle (0 = empty cell); returns 1 and fills solution if one exists
+int solveExact(const int puzzle[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE]) {
+    ExactSearch search;
+    if(!loadPuzzle(&search, puzzle, 1)) return 0;
+
+    searchCells(&search);
+    if(search.solutions == 0) return 0;
+
+    memcpy(solution, search.solution, sizeof(search.solution));
+    return 1;
+}
+
+// Count solutions, stopping early once limit is reached (limit 2 checks uniqueness)
+long countSolutions(const int puzzle[BOARD_SIZE][BOARD_SIZE], long limit) {
+    ExactSearch search;
+    if(!loadPuzzle(&search, puzzle, limit)) return 0;
+
+    searchCells(&search);
+    return search.solutions;
+}
+
+// Solve a board from its fixed numbers - standalone exact mode
+int solveBoardExact(SudokuBoard* board) {
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    if(!solveExact(board->initial, solution)) return 0;
+
+    memcpy(board->board, solution, sizeof(solution));
+    calculateFitness(board);
+    return 1;
+}
+
+// Hybrid finisher - keep the generated numbers of a GA individual that have
+// no conflicts, clear the rest and complete the board exactly. Falls back to
+// the fixed numbers alone if the kept numbers cannot be completed.
+int finishBoard(SudokuBoard* board) {
+    int rowCount[BOARD_SIZE][10] = {{0}};
+    int colCount[BOARD_SIZE][10] = {{0}};
+    int blockCount[BOARD_SIZE][10] = {{0}};
+
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int num = board->board[row][col];
+            if(num < 1 || num > 9) continue;
+            rowCount[row][num]++;
+            colCount[col][num]++;
+            blockCount[blockIndex(row, col)][num]++;
+        }
+    }
+
+    int partial[BOARD_SIZE][BOARD_SIZE];
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int num = board->board[row][col];
+            int conflicting = num < 1 || num > 9 ||
+                              rowCount[row][num] > 1 ||
+                              colCount[col][num] > 1 ||
+                              blockCount[blockIndex(row, col)][num] > 1;
+            partial[row][col] = (isFixed(board, row, col) || !conflicting) ? num : 0;
+        }
+    }
+
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    if(!solveExact(partial, solution) && !solveExact(board->initial, solution)) {
+        return 0;
+    }
+
+    memcpy(board->board, solution, sizeof(solution));
+    calculateFitness(board);
+    return 1;
+}
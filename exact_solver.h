@@ -0,0 +1,12 @@
+#ifndef EXACT_SOLVER_H
+#define EXACT_SOLVER_H
+
+#include "sudoku.h"
+
+// Exact solver (bitmask candidate backtracking)
+int solveExact(const int puzzle[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE]);
+long countSolutions(const int puzzle[BOARD_SIZE][BOARD_SIZE], long limit);
+int solveBoardExact(SudokuBoard* board);
+int finishBoard(SudokuBoard* board);
+
+#endif
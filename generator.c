@@ -0,0 +1,234 @@
+#include "generator.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "sudoku.h"
+#include "exact_solver.h"
+#include "solver.h"
+#include "puzzle_io.h"
+#include "timing.h"
+#include "rng.h"
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+
+// Random permutation of 0..count-1 (Fisher-Yates)
+static void shuffleValues(int* values, int count, RandomState* random) {
+    for(int i = 0; i < count; i++) values[i] = i;
+    for(int i = count - 1; i > 0; i--) {
+        int j = randomInt(random, i + 1);
+        int swap = values[i];
+        values[i] = values[j];
+        values[j] = swap;
+    }
+}
+
+
+// === PUZZLE GENERATOR ===
+
+// Random complete grid. The three diagonal blocks share no row or column, so
+// any digit order in them is consistent; the exact solver completes the rest.
+void generateSolvedGrid(int grid[BOARD_SIZE][BOARD_SIZE], RandomState* random) {
+    int seeded[BOARD_SIZE][BOARD_SIZE] = {{0}};
+    int digits[BOARD_SIZE];
+
+    for(int block = 0; block < BLOCK_SIZE; block++) {
+        shuffleValues(digits, BOARD_SIZE, random);
+        for(int i = 0; i < BOARD_SIZE; i++) {
+            seeded[block * BLOCK_SIZE + i / BLOCK_SIZE][block * BLOCK_SIZE + i % BLOCK_SIZE] = digits[i] + 1;
+        }
+    }
+
+    solveExact(seeded, grid);
+}
+
+// Clear clues in random order, keeping every removal after which the puzzle
+// still has exactly one solution. Stops at minClues (0 = until no clue can
+// go). Returns the number of clues left.
+int removeClues(int puzzle[BOARD_SIZE][BOARD_SIZE], int minClues, RandomState* random) {
+    int order[CELL_COUNT];
+    shuffleValues(order, CELL_COUNT, random);
+
+    int clues = 0;
+    for(int i = 0; i < CELL_COUNT; i++) {
+        if(puzzle[i / BOARD_SIZE][i % BOARD_SIZE] != 0) clues++;
+    }
+
+    for(int i = 0; i < CELL_COUNT && clues > minClues; i++) {
+        int row = order[i] / BOARD_SIZE, col = order[i] % BOARD_SIZE;
+        int num = puzzle[row][col];
+        if(num == 0) continue;
+
+        puzzle[row][col] = 0;
+        if(countSolutions(puzzle, 2) == 1) clues--;
+        else puzzle[row][col] = num;
+    }
+
+    return clues;
+}
+
+// New puzzle with a unique solution (not rated yet)
+void generatePuzzle(GeneratedPuzzle* generated, int minClues, RandomState* random) {
+    generateSolvedGrid(generated->solution, random);
+    memcpy(generated->puzzle, generated->solution, sizeof(generated->puzzle));
+    generated->clues = removeClues(generated->puzzle, minClues, random);
+    generated->rating = 0;
+    generated->ratingFitness = 0;
+    generated->ratingStop = STOP_NONE;
+}
+
+// Rate a puzzle by the fitness evaluations the solver needs for it - with the
+// rating parameters of generatePuzzles(), until it first reaches
+// RATING_FITNESS. Puzzles it does not reach that within its budget are at
+// least that hard, and the best fitness it reached tells those apart.
+void ratePuzzle(SudokuSolver* solver, GeneratedPuzzle* generated) {
+    SolveResult result = solve(solver, generated->puzzle);
+    generated->rating = result.evaluations;
+    generated->ratingFitness = result.best.fitness;
+    generated->ratingStop = result.reason;
+}
+
+static int ratingReached(const GeneratedPuzzle* generated) {
+    return generated->ratingStop == STOP_TARGET_REACHED || generated->ratingStop == STOP_SOLVED;
+}
+
+// Output line: 81 cells, clue count and, if rated, the rating - evaluations
+// ('+' = rating fitness not reached) and the best fitness reached. Returns the length.
+int formatGenerated(const GeneratedPuzzle* generated, int rated, char* line, size_t size) {
+    char cells[CELL_COUNT + 1];
+    for(int i = 0; i < CELL_COUNT; i++) {
+        int num = generated->puzzle[i / BOARD_SIZE][i % BOARD_SIZE];
+        cells[i] = num ? (char)('0' + num) : '.';
+    }
+    cells[CELL_COUNT] = 0;
+
+    if(!rated) return snprintf(line, size, "%s %d\n", cells, generated->clues);
+    return snprintf(line, size, "%s %d %ld%s %d\n", cells, generated->clues, generated->rating,
+                    ratingReached(generated) ? "" : "+", generated->ratingFitness);
+}
+
+
+// === PARALLEL GENERATION ===
+
+// Shared state of the generator threads
+typedef struct {
+    const GAParameters* parameters;  // Rating solver parameters (NULL = no rating)
+    ResultWriter* writer;
+    pthread_mutex_t writerLock;
+    atomic_long next;                // Puzzles claimed so far
+    long count;
+    int minClues;
+    unsigned long long seed;
+} GeneratorRun;
+
+// One generator thread and its totals
+typedef struct {
+    GeneratorRun* run;
+    int id;
+    GeneratorStats stats;
+} GeneratorWorker;
+
+static void* runGeneratorWorker(void* argument) {
+    GeneratorWorker* worker = (GeneratorWorker*)argument;
+    GeneratorRun* run = worker->run;
+    GeneratorStats* stats = &worker->stats;
+
+    // Each thread draws from its own generator; the rating solver has another
+    RandomState random;
+    seedRandom(&random, run->seed + (unsigned long long)worker->id * 0x9E3779B97F4A7C15ull);
+    SudokuSolver* solver = NULL;
+    if(run->parameters) {
+        // Without memory for its solver the thread leaves the work to the others
+        solver = createSolver(run->parameters);
+        if(!solver) return NULL;
+        setSolverSeed(solver, run->seed ^ ((unsigned long long)worker->id << 32));
+    }
+
+    GeneratedPuzzle generated;
+    char line[128];
+    while(atomic_fetch_add(&run->next, 1) < run->count) {
+        double start = cpuTimeSeconds();
+        generatePuzzle(&generated, run->minClues, &random);
+        double made = cpuTimeSeconds();
+        stats->generateSeconds += made - start;
+
+        if(solver) {
+            ratePuzzle(solver, &generated);
+            stats->rateSeconds += cpuTimeSeconds() - made;
+            stats->evaluations += generated.rating;
+            if(ratingReached(&generated)) stats->reachedTarget++;
+        }
+        stats->puzzles++;
+        stats->clues += generated.clues;
+
+        int length = formatGenerated(&generated, solver != NULL, line, sizeof(line));
+        pthread_mutex_lock(&run->writerLock);
+        writeText(run->writer, line, (size_t)length);
+        pthread_mutex_unlock(&run->writerLock);
+    }
+
+    destroySolver(solver);
+    return NULL;
+}
+
+// Generate count puzzles on up to threads threads and stream them to writer
+// in completion order, one formatGenerated() line each. Puzzles are rated
+// with parameters (the genetic algorithm alone - no finisher, no events);
+// NULL parameters skips rating. Thread i draws from a generator seeded from
+// seed and i. Fills stats with the totals of all threads, the wall-clock
+// time and the number of threads that ran; stats->puzzles falls short of
+// count only if no thread could allocate its rating solver.
+void generatePuzzles(const GAParameters* parameters, long count, int minClues, int threads,
+                     unsigned long long seed, ResultWriter* writer, GeneratorStats* stats) {
+    GAParameters ratingParameters;
+    if(parameters) {
+        ratingParameters = *parameters;
+        ratingParameters.hybridFinisher = 0;
+        ratingParameters.verbose = 0;
+        // A fixed fitness target and a bounded budget - left to stagnate, the
+        // GA runs ~65k evaluations on every minimal puzzle and solves none
+        ratingParameters.targetFitness = RATING_FITNESS;
+        if(ratingParameters.maxEvaluations <= 0 || ratingParameters.maxEvaluations > RATING_MAX_EVALUATIONS) {
+            ratingParameters.maxEvaluations = RATING_MAX_EVALUATIONS;
+        }
+    }
+
+    GeneratorRun run;
+    run.parameters = parameters ? &ratingParameters : NULL;
+    run.writer = writer;
+    pthread_mutex_init(&run.writerLock, NULL);
+    atomic_init(&run.next, 0);
+    run.count = count;
+    run.minClues = minClues;
+    run.seed = seed;
+
+    if(threads < 1) threads = 1;
+    if(threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+    GeneratorWorker workers[MAX_WORKER_THREADS];
+    pthread_t handles[MAX_WORKER_THREADS];
+    memset(workers, 0, sizeof(workers));
+
+    double start = wallTimeSeconds();
+    int started = 0;
+    for(int i = 0; i < threads; i++) {
+        workers[i].run = &run;
+        workers[i].id = i;
+        if(pthread_create(&handles[i], NULL, runGeneratorWorker, &workers[i]) != 0) break;
+        started++;
+    }
+    if(started == 0) runGeneratorWorker(&workers[0]);
+    for(int i = 0; i < started; i++) pthread_join(handles[i], NULL);
+
+    memset(stats, 0, sizeof(GeneratorStats));
+    stats->seconds = wallTimeSeconds() - start;
+    stats->threads = started > 0 ? started : 1;
+    for(int i = 0; i < threads; i++) {
+        stats->puzzles += workers[i].stats.puzzles;
+        stats->clues += workers[i].stats.clues;
+        stats->evaluations += workers[i].stats.evaluations;
+        stats->reachedTarget += workers[i].stats.reachedTarget;
+        stats->generateSeconds += workers[i].stats.generateSeconds;
+        stats->rateSeconds += workers[i].stats.rateSeconds;
+    }
+
+    pthread_mutex_destroy(&run.writerLock);
+}
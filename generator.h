@@ -0,0 +1,16 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "sudoku.h"
+
+// Puzzle generator - exact seeding, uniqueness-checked clue removal and
+// difficulty rating by the genetic algorithm
+void generateSolvedGrid(int grid[BOARD_SIZE][BOARD_SIZE], RandomState* random);
+int removeClues(int puzzle[BOARD_SIZE][BOARD_SIZE], int minClues, RandomState* random);
+void generatePuzzle(GeneratedPuzzle* generated, int minClues, RandomState* random);
+void ratePuzzle(SudokuSolver* solver, GeneratedPuzzle* generated);
+int formatGenerated(const GeneratedPuzzle* generated, int rated, char* line, size_t size);
+void generatePuzzles(const GAParameters* parameters, long count, int minClues, int threads,
+                     unsigned long long seed, ResultWriter* writer, GeneratorStats* stats);
+
+#endif
@@ -1,15 +1,95 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <string.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <conio.h>
+#include <windows.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
 #include "sudoku.h"
+#include "board_operations.h"
+#include "parameters.h"
+#include "puzzle_io.h"
+#include "timing.h"
+#include "event_log.h"
+#include "budget.h"
+#include "solver.h"
+#include "generator.h"
+#include "verifier.h"
+
+#define DEFAULT_CONFIG_FILE "sudoku.cfg"
+
+// Solve running on a worker thread while the front end renders progress
+typedef struct {
+    SudokuSolver* solver;
+    SolveResult result;
+    atomic_int done;
+} SolveJob;
 
 void clearScreen() {
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
+    fflush(stdout);
+#ifdef _WIN32
+    // Console API clear - no shell is started
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    COORD origin = {0, 0};
+    DWORD written;
+    if(!GetConsoleScreenBufferInfo(console, &info)) return;
+    DWORD cells = (DWORD)info.dwSize.X * info.dwSize.Y;
+    FillConsoleOutputCharacter(console, ' ', cells, origin, &written);
+    FillConsoleOutputAttribute(console, info.wAttributes, cells, origin, &written);
+    SetConsoleCursorPosition(console, origin);
+#else
+    fputs("\033[2J\033[H", stdout);  // ANSI clear - no shell is started
+    fflush(stdout);
+#endif
+}
+
+// Wait up to timeoutMs for a line on stdin; returns 1 if one was read
+int waitForLine(int timeoutMs, int* inputClosed) {
+    char line[64];
+    if(*inputClosed) {
+#ifdef _WIN32
+        Sleep(timeoutMs);
+#else
+        struct timespec pause = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        nanosleep(&pause, NULL);
+#endif
+        return 0;
+    }
+#ifdef _WIN32
+    Sleep(timeoutMs);
+    if(!_kbhit()) return 0;
+#else
+    struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+    if(poll(&input, 1, timeoutMs) <= 0) return 0;
+#endif
+    if(fgets(line, sizeof(line), stdin) == NULL) {
+        *inputClosed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+void* runSolveJob(void* argument) {
+    SolveJob* job = (SolveJob*)argument;
+    job->result = solve(job->solver, INITIAL_PUZZLE);
+    atomic_store(&job->done, 1);
+    return NULL;
+}
+
+void renderProgress(const SolverProgress* progress, double elapsed) {
+    printf("\rGeneration %5d | Best fitness %3d/243 | Improvements %3d | %6.1f s | Enter = cancel ",
+           atomic_load_explicit(&progress->generation, memory_order_relaxed),
+           atomic_load_explicit(&progress->bestFitness, memory_order_relaxed),
+           atomic_load_explicit(&progress->improvements, memory_order_relaxed),
+           elapsed);
+    fflush(stdout);
 }
 
 void showCurrentSettings(SelectionType sel, CrossoverType cross, MutationType mut) {
@@ -17,12 +97,8 @@ void showCurrentSettings(SelectionType sel, CrossoverType cross, MutationType mu
     printf("Selection: %s\n", 
            sel == TOURNAMENT ? "Tournament" : 
            sel == ROULETTE ? "Roulette" : "Ranking");
-    printf("Crossover: %s\n",
-           cross == SINGLE_POINT ? "Single Point" :
-           cross == MULTI_POINT ? "Multi Point" : "Uniform");
-    printf("Mutation: %s\n",
-           mut == ROW_SWAP ? "Row Swap" :
-           mut == BLOCK_SWAP ? "Block Swap" : "Random Change");
+    printf("Crossover: %s\n", crossoverName(cross));
+    printf("Mutation: %s\n", mutationName(mut));
 }
 
 void showSelectionMenu() {
@@ -39,6 +115,9 @@ void showCrossoverMenu() {
     printf("1. Single Point (3x3 block exchange)\n");
     printf("2. Multi Point (multiple blocks)\n");
     printf("3. Uniform (random for each cell)\n");
+    printf("4. Row (random subset of rows)\n");
+    printf("5. Band (one band of three blocks)\n");
+    printf("6. Adaptive (bandit picks the operator per offspring)\n");
 }
 
 void showMutationMenu() {
@@ -47,15 +126,331 @@ void showMutationMenu() {
     printf("1. Row Swap (swap numbers in a row)\n");
     printf("2. Block Swap (swap 3x3 blocks)\n");
     printf("3. Random Change (change random number)\n");
+    printf("4. Conflict Change (re-pick a conflicting number)\n");
+    printf("5. Conflict Swap (swap a conflicting number in its row or block)\n");
+    printf("6. Adaptive (bandit picks the operator per offspring)\n");
+}
+
+
+void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [config-file] [--batch <puzzle-file> <output-file>] [--exact]\n"
+                    "       %s [config-file] --generate <count> <output-file> [--threads <n>]\n"
+                    "       %s --verify <puzzle-file> <solution-file> <report-file> [--bitmap <file>]\n",
+            program, program, program);
+    fprintf(stderr, "  config-file   parameters to load (default %s if present)\n", DEFAULT_CONFIG_FILE);
+    fprintf(stderr, "  --batch       solve every puzzle of a file (81 characters per line,\n");
+    fprintf(stderr, "                '.' or '0' for empty cells), writing one line per input line;\n");
+    fprintf(stderr, "                output '-' writes to stdout\n");
+    fprintf(stderr, "  --exact       use the exact solver instead of the genetic algorithm\n");
+    fprintf(stderr, "  --generate <count> <output-file>  write new puzzles with a unique solution,\n");
+    fprintf(stderr, "                one per line: puzzle, clues and difficulty rating (GA evaluations\n");
+    fprintf(stderr, "                to reach fitness %d, '+' = not within %d)\n", RATING_FITNESS, RATING_MAX_EVALUATIONS);
+    fprintf(stderr, "                (evaluations, '+' if not solved unaided, best fitness)\n");
+    fprintf(stderr, "  --clues <n>   stop removing clues at n (default: minimal puzzles)\n");
+    fprintf(stderr, "  --no-rating   skip the genetic algorithm difficulty rating\n");
+    fprintf(stderr, "  --verify      check solutions line by line against their puzzles; the report\n");
+    fprintf(stderr, "                lists failed entries with their bad rows, columns and blocks\n");
+    fprintf(stderr, "  --bitmap <file>  with --verify, write one pass bit per entry\n");
+    fprintf(stderr, "  --threads <n> worker threads for --generate and --verify (default: number of cores)\n");
+    fprintf(stderr, "  --time-limit <seconds>  wall-clock budget per solve (0 = none)\n");
+    fprintf(stderr, "  --log <file>  record solver events ('-' for stderr)\n");
+    fprintf(stderr, "  --log-format plain|json\n");
+    fprintf(stderr, "  --log-level debug|info|warning\n");
+}
+
+// Solve every puzzle of a file and stream the solutions in the same format,
+// one output line per input line so that line N of the output belongs to
+// line N of the input (see --verify). Puzzles without a solution are written
+// back as they are; blank, '#' and malformed lines are copied unchanged.
+int runBatch(SudokuSolver* solver, const char* inputPath, const char* outputPath, int exactOnly) {
+    PuzzleCorpus corpus;
+    ResultWriter writer;
+    if(!openCorpus(&corpus, inputPath)) {
+        fprintf(stderr, "Cannot read puzzles from %s\n", inputPath);
+        return 1;
+    }
+    if(!openResultWriter(&writer, outputPath)) {
+        fprintf(stderr, "Cannot write results to %s\n", outputPath);
+        closeCorpus(&corpus);
+        return 1;
+    }
+
+    long total = 0, solved = 0;
+    double start = wallTimeSeconds();
+
+    CompactPuzzle puzzle;
+    LineKind kind;
+    int grid[BOARD_SIZE][BOARD_SIZE];
+    while(nextLine(&corpus, &puzzle, &kind)) {
+        if(kind != LINE_PUZZLE) {
+            writeText(&writer, corpus.line, corpus.lineLength);
+            writeText(&writer, "\n", 1);
+            continue;
+        }
+
+        expandPuzzle(&puzzle, grid);
+        total++;
+
+        if(exactOnly) {
+            int solution[BOARD_SIZE][BOARD_SIZE];
+            if(solveExact(grid, solution)) {
+                writeGrid(&writer, solution);
+                solved++;
+            } else {
+                writeGrid(&writer, grid);
+            }
+        } else {
+            SolveResult result = solve(solver, grid);
+            writeGrid(&writer, result.best.fitness == 243 ? result.best.board : grid);
+            if(result.best.fitness == 243) solved++;
+        }
+    }
+
+    double seconds = wallTimeSeconds() - start;
+    long invalid = corpus.invalidLines;
+    closeCorpus(&corpus);
+    if(!closeResultWriter(&writer)) {
+        fprintf(stderr, "Failed to write results to %s\n", outputPath);
+        return 1;
+    }
+
+    fprintf(stderr, "%ld puzzles, %ld solved, %ld invalid lines copied, %.2f s (%.0f puzzles/s)\n",
+            total, solved, invalid, seconds, seconds > 0.0 ? total / seconds : 0.0);
+    return 0;
+}
+
+
+int coreCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+#endif
+}
+
+// Generate puzzles on several threads and stream them out as they are made
+// (in completion order). Reports the overall throughput and, separately, the
+// cost of generating and of rating one puzzle.
+int runGenerator(const GAParameters* parameters, long count, const char* outputPath,
+                 int threads, int minClues, int rate) {
+    ResultWriter writer;
+    if(!openResultWriter(&writer, outputPath)) {
+        fprintf(stderr, "Cannot write puzzles to %s\n", outputPath);
+        return 1;
+    }
+
+    GeneratorStats stats;
+    generatePuzzles(rate ? parameters : NULL, count, minClues, threads,
+                    (unsigned long long)time(NULL), &writer, &stats);
+    if(!closeResultWriter(&writer)) {
+        fprintf(stderr, "Failed to write puzzles to %s\n", outputPath);
+        return 1;
+    }
+
+    if(stats.puzzles < count) {
+        fprintf(stderr, "Failed to allocate the rating solvers!\n");
+        return 1;
+    }
+
+    long made = stats.puzzles > 0 ? stats.puzzles : 1;
+    fprintf(stderr, "%ld puzzles, %d threads, %.2f s (%.1f puzzles/s), %.1f clues on average\n",
+            stats.puzzles, stats.threads, stats.seconds,
+            stats.seconds > 0.0 ? stats.puzzles / stats.seconds : 0.0, (double)stats.clues / made);
+    fprintf(stderr, "Generating: %.2f ms CPU per puzzle (%.0f puzzles/s per thread)\n",
+            1000.0 * stats.generateSeconds / made,
+            stats.generateSeconds > 0.0 ? stats.puzzles / stats.generateSeconds : 0.0);
+    if(rate) {
+        fprintf(stderr, "Rating: %.2f ms CPU per puzzle, %.0f evaluations on average, "
+                        "%ld of %ld reached fitness %d within %d evaluations\n",
+                1000.0 * stats.rateSeconds / made, (double)stats.evaluations / made,
+                stats.reachedTarget, stats.puzzles, RATING_FITNESS, RATING_MAX_EVALUATIONS);
+    }
+    return 0;
+}
+
+
+// Check the solutions of a file against the puzzles of another, line N
+// against line N (e.g. the input and output of --batch). Failed lines go to
+// the report, one pass bit per line to the optional bitmap. Returns 0 if
+// every line passed and neither file has surplus lines, 1 otherwise, 2 on
+// I/O errors.
+int runVerify(const char* puzzlePath, const char* solutionPath, const char* reportPath,
+              const char* bitmapPath, int threads) {
+    PuzzleCorpus puzzleCorpus, solutionCorpus;
+    ResultWriter report, bitmap;
+    if(!openCorpus(&puzzleCorpus, puzzlePath)) {
+        fprintf(stderr, "Cannot read puzzles from %s\n", puzzlePath);
+        return 2;
+    }
+    if(!openCorpus(&solutionCorpus, solutionPath)) {
+        fprintf(stderr, "Cannot read solutions from %s\n", solutionPath);
+        closeCorpus(&puzzleCorpus);
+        return 2;
+    }
+    if(!openResultWriter(&report, reportPath)) {
+        fprintf(stderr, "Cannot write the report to %s\n", reportPath);
+        closeCorpus(&puzzleCorpus);
+        closeCorpus(&solutionCorpus);
+        return 2;
+    }
+    if(bitmapPath && !openResultWriter(&bitmap, bitmapPath)) {
+        fprintf(stderr, "Cannot write the bitmap to %s\n", bitmapPath);
+        closeResultWriter(&report);
+        closeCorpus(&puzzleCorpus);
+        closeCorpus(&solutionCorpus);
+        return 2;
+    }
+
+    VerifyStats stats;
+    int verified = verifyCorpora(&puzzleCorpus, &solutionCorpus, threads, &report,
+                                 bitmapPath ? &bitmap : NULL, &stats);
+    closeCorpus(&puzzleCorpus);
+    closeCorpus(&solutionCorpus);
+
+    int written = closeResultWriter(&report);
+    if(bitmapPath && !closeResultWriter(&bitmap)) written = 0;
+    if(!verified) {
+        fprintf(stderr, "Failed to allocate verification buffers!\n");
+        return 2;
+    }
+    if(!written) {
+        fprintf(stderr, "Failed to write the verification results\n");
+        return 2;
+    }
+
+    fprintf(stderr, "%ld lines, %ld checked, %ld passed, %ld failed (%ld rows, %ld columns, %ld blocks, "
+            "%ld changed clues, %ld malformed puzzles, %ld malformed solutions)\n",
+            stats.lines, stats.checked, stats.checked - stats.failed, stats.failed,
+            stats.badRows, stats.badColumns, stats.badBlocks, stats.changedClues,
+            stats.malformedPuzzles, stats.malformedSolutions);
+    fprintf(stderr, "Surplus lines: %ld puzzles, %ld solutions\n",
+            stats.surplusPuzzles, stats.surplusSolutions);
+    fprintf(stderr, "%d threads, %.2f s (%.0f solutions/s)\n",
+            threads, stats.seconds, stats.seconds > 0.0 ? stats.checked / stats.seconds : 0.0);
+    return stats.failed == 0 && stats.surplusPuzzles == 0 && stats.surplusSolutions == 0 ? 0 : 1;
 }
 
 
-int main(void) {
-    srand(time(NULL));
+int main(int argc, char* argv[]) {
+    const char* configPath = NULL;
+    const char* batchInput = NULL;
+    const char* batchOutput = NULL;
+    int exactOnly = 0;
+    const char* logPath = NULL;
+    EventFormat logFormat = EVENT_FORMAT_PLAIN;
+    EventLevel logLevel = EVENT_INFO;
+    double timeLimit = -1.0;
+    long generateCount = 0;
+    const char* generateOutput = NULL;
+    int threads = coreCount();
+    int minClues = GENERATOR_MIN_CLUES;
+    int rate = 1;
+    const char* verifyPuzzles = NULL;
+    const char* verifySolutionsPath = NULL;
+    const char* verifyReport = NULL;
+    const char* bitmapPath = NULL;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            logPath = argv[++i];
+        } else if(strcmp(argv[i], "--log-format") == 0 && i + 1 < argc) {
+            logFormat = strcmp(argv[++i], "json") == 0 ? EVENT_FORMAT_JSON : EVENT_FORMAT_PLAIN;
+        } else if(strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            i++;
+            logLevel = strcmp(argv[i], "debug") == 0 ? EVENT_DEBUG :
+                       strcmp(argv[i], "warning") == 0 ? EVENT_WARNING : EVENT_INFO;
+        } else if(strcmp(argv[i], "--batch") == 0 && i + 2 < argc) {
+            batchInput = argv[++i];
+            batchOutput = argv[++i];
+        } else if(strcmp(argv[i], "--exact") == 0) {
+            exactOnly = 1;
+        } else if(strcmp(argv[i], "--time-limit") == 0 && i + 1 < argc) {
+            timeLimit = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--generate") == 0 && i + 2 < argc) {
+            generateCount = atol(argv[++i]);
+            generateOutput = argv[++i];
+        } else if(strcmp(argv[i], "--clues") == 0 && i + 1 < argc) {
+            minClues = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--no-rating") == 0) {
+            rate = 0;
+        } else if(strcmp(argv[i], "--verify") == 0 && i + 3 < argc) {
+            verifyPuzzles = argv[++i];
+            verifySolutionsPath = argv[++i];
+            verifyReport = argv[++i];
+        } else if(strcmp(argv[i], "--bitmap") == 0 && i + 1 < argc) {
+            bitmapPath = argv[++i];
+        } else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if(argv[i][0] != '-' && !configPath) {
+            configPath = argv[i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Parameters from the given file (e.g. written by the tuner) or sudoku.cfg if present
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    if(configPath) {
+        if(!loadParameters(configPath, &parameters)) {
+            fprintf(stderr, "Cannot read parameters from %s\n", configPath);
+            return 1;
+        }
+    } else {
+        loadParameters(DEFAULT_CONFIG_FILE, &parameters);
+    }
+    if(timeLimit >= 0.0) parameters.timeLimit = timeLimit;
+
+    if(threads < 1) threads = 1;
+    if(threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+
+    if(verifyPuzzles) {
+        return runVerify(verifyPuzzles, verifySolutionsPath, verifyReport, bitmapPath, threads);
+    }
+
+    if(generateOutput) {
+        return runGenerator(&parameters, generateCount, generateOutput, threads, minClues, rate);
+    }
+
+    if(batchInput) {
+        parameters.verbose = 0;
+        SudokuSolver* solver = createSolver(&parameters);
+        if(!solver) {
+            fprintf(stderr, "Failed to allocate solver!\n");
+            return 1;
+        }
+        setSolverSeed(solver, (unsigned long long)time(NULL));
+        int status = runBatch(solver, batchInput, batchOutput, exactOnly);
+        destroySolver(solver);
+        return status;
+    }
+
+    // Events are formatted and written by the log's own thread
+    FILE* logFile = NULL;
+    EventLog* eventLog = NULL;
+    if(logPath) {
+        logFile = strcmp(logPath, "-") == 0 ? stderr : fopen(logPath, "w");
+        if(logFile) eventLog = createEventLog(logFile, logFormat, logLevel);
+        if(!eventLog) {
+            fprintf(stderr, "Cannot open event log %s\n", logPath);
+            return 1;
+        }
+    }
+
+    SudokuSolver* solver = createSolver(&parameters);
+    if(!solver) {
+        fprintf(stderr, "Failed to allocate solver!\n");
+        return 1;
+    }
+    setSolverSeed(solver, (unsigned long long)time(NULL));
+    setSolverLog(solver, eventLog);
 
-    SelectionType selectionType = TOURNAMENT;
-    CrossoverType crossoverType = SINGLE_POINT;
-    MutationType mutationType = ROW_SWAP;
+    SelectionType selectionType = parameters.selection;
+    CrossoverType crossoverType = parameters.crossover;
+    MutationType mutationType = parameters.mutation;
     char input[10];
 
     while(1) {
@@ -69,15 +464,21 @@ int main(void) {
         printf("2. Change Crossover Method\n");
         printf("3. Change Mutation Method\n");
         printf("4. Start Solving\n");
-        printf("5. Exit\n");
+        printf("5. Solve Exactly (backtracking, no genetic algorithm)\n");
+        printf("6. Exit\n");
         
-        printf("\nEnter your choice (1-5): ");
+        printf("\nEnter your choice (1-6): ");
         fflush(stdout);
         if (fgets(input, sizeof(input), stdin) == NULL) continue;
         input[strcspn(input, "\n")] = 0;
 
-        if(input[0] == '5') {
+        if(input[0] == '6') {
             printf("\nThank you for using Sudoku Solver!\n");
+            destroySolver(solver);
+            if(eventLog) {
+                destroyEventLog(eventLog);
+                if(logFile != stderr) fclose(logFile);
+            }
             return 0;
         }
 
@@ -97,26 +498,32 @@ int main(void) {
 
             case '2': {
                 showCrossoverMenu();
-                printf("\nEnter your choice (1-3): ");
+                printf("\nEnter your choice (1-6): ");
                 fflush(stdout);
                 if (fgets(input, sizeof(input), stdin) == NULL) continue;
                 switch(input[0]) {
                     case '1': crossoverType = SINGLE_POINT; break;
                     case '2': crossoverType = MULTI_POINT; break;
                     case '3': crossoverType = UNIFORM; break;
+                    case '4': crossoverType = ROW_CROSSOVER; break;
+                    case '5': crossoverType = BAND_CROSSOVER; break;
+                    case '6': crossoverType = ADAPTIVE_CROSSOVER; break;
                 }
                 break;
             }
 
             case '3': {
                 showMutationMenu();
-                printf("\nEnter your choice (1-3): ");
+                printf("\nEnter your choice (1-6): ");
                 fflush(stdout);
                 if (fgets(input, sizeof(input), stdin) == NULL) continue;
                 switch(input[0]) {
                     case '1': mutationType = ROW_SWAP; break;
                     case '2': mutationType = BLOCK_SWAP; break;
                     case '3': mutationType = RANDOM_CHANGE; break;
+                    case '4': mutationType = CONFLICT_CHANGE; break;
+                    case '5': mutationType = CONFLICT_SWAP; break;
+                    case '6': mutationType = ADAPTIVE_MUTATION; break;
                 }
                 break;
             }
@@ -126,41 +533,114 @@ int main(void) {
                 printf("=== STARTING SUDOKU SOLVER ===\n\n");
                 printf("Using:\n");
                 showCurrentSettings(selectionType, crossoverType, mutationType);
-                printf("\nInitializing population...\n");
 
-                Population* population = createPopulation();
-                printf("Initial puzzle:\n");
-                printBoard(&population->boards[0]);
+                SudokuBoard puzzle;
+                setInitialPuzzle(&puzzle, INITIAL_PUZZLE);
+                calculateFitness(&puzzle);
+                printf("\nInitial puzzle:\n");
+                printBoard(&puzzle);
 
-                printf("\nStarting evolution...\n");
-                printf("Press Enter to continue...");
-                getchar();
+                printf("\nStarting evolution...\n\n");
+
+                parameters.selection = selectionType;
+                parameters.crossover = crossoverType;
+                parameters.mutation = mutationType;
+                if(!setSolverParameters(solver, &parameters)) {
+                    printf("Failed to allocate the population!\n");
+                    printf("\nPress Enter to return to menu...");
+                    getchar();
+                    break;
+                }
+
+                // Solve on a worker thread; this thread only redraws progress
+                // and watches for a cancel request
+                SolveJob job;
+                job.solver = solver;
+                atomic_init(&job.done, 0);
+                const SolverProgress* progress = getSolverProgress(solver);
 
-                clock_t start = clock();
-                SudokuBoard solution = evolve(population, selectionType,
-                                            crossoverType, mutationType);
-                clock_t end = clock();
-                double time_spent = (double)(end - start) / CLOCKS_PER_SEC;
+                double start = wallTimeSeconds();
+                pthread_t worker;
+                if(pthread_create(&worker, NULL, runSolveJob, &job) != 0) {
+                    runSolveJob(&job);
+                } else {
+                    int inputClosed = 0;
+                    while(!atomic_load(&job.done)) {
+                        renderProgress(progress, wallTimeSeconds() - start);
+                        // Once the worker is done a cancel has nothing left to stop
+                        if(waitForLine(UI_REFRESH_MS, &inputClosed) && !atomic_load(&job.done)) {
+                            cancelSolve(solver);
+                        }
+                    }
+                    pthread_join(worker, NULL);
+                }
+                double time_spent = wallTimeSeconds() - start;
+                renderProgress(progress, time_spent);
+                printf("\n");
+
+                SudokuBoard solution = job.result.best;
+                if(job.result.reason == STOP_CANCELLED) {
+                    printf("\nSolving cancelled - showing the best board so far.\n");
+                }
 
                 printf("\n=== FINAL SOLUTION ===\n");
                 printBoard(&solution);
-                printf("\nExecution time: %.2f seconds\n", time_spent);
+                printf("\nStopped by: %s after %d generations, %ld evaluations\n",
+                       stopReasonName(job.result.reason), job.result.generations,
+                       job.result.evaluations);
+                printf("Execution time: %.2f seconds\n", time_spent);
 
                 if(solution.fitness == 243) {
                     printf("Perfect solution found!\n");
+
+                    // Cross-check against the exact solver
+                    int expected[BOARD_SIZE][BOARD_SIZE];
+                    if(countSolutions(solution.initial, 2) == 1 &&
+                       solveExact(solution.initial, expected)) {
+                        printf("Matches exact solver: %s\n",
+                               memcmp(expected, solution.board, sizeof(expected)) == 0 ? "yes" : "NO");
+                    }
                 } else {
                     printf("No perfect solution found.\n");
                     printf("Current solution quality: %.1f%%\n",
                            (solution.fitness * 100.0) / 243.0);
                 }
 
-                destroyPopulation(population);
                 printf("\nPress Enter to return to menu...");
                 getchar();
                 clearScreen();
                 break;
 
             }
+
+            case '5': {
+                clearScreen();
+                printf("=== EXACT SOLVER ===\n\n");
+
+                SudokuBoard board;
+                setInitialPuzzle(&board, INITIAL_PUZZLE);
+                calculateFitness(&board);
+                printf("Initial puzzle:\n");
+                printBoard(&board);
+
+                double start = wallTimeSeconds();
+                int solved = solveBoardExact(&board);
+                long solutions = countSolutions(board.initial, 2);
+                double time_spent = wallTimeSeconds() - start;
+
+                if(solved) {
+                    printf("\n=== FINAL SOLUTION ===\n");
+                    printBoard(&board);
+                    printf("\nPuzzle has %s solution.\n", solutions > 1 ? "more than one" : "a unique");
+                } else {
+                    printf("\nPuzzle has no solution.\n");
+                }
+                printf("Execution time: %.4f seconds\n", time_spent);
+
+                printf("\nPress Enter to return to menu...");
+                getchar();
+                break;
+            }
         }
     }
 }
\ No newline at end of file
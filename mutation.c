@@ -1,94 +1,220 @@
 #include "mutation.h"
 #include <stdlib.h>
+#include <string.h>
 #include "sudoku.h"
+#include "board_operations.h"
+#include "puzzle_index.h"
+#include "rng.h"
 
 
 // === MUTATION OPERATORS ===
 
-void mutate(SudokuBoard* board, MutationType type) {
+void mutate(SudokuBoard* board, MutationType type, RandomState* random) {
     switch(type) {
         case ROW_SWAP:
-            rowSwapMutation(board);
+            rowSwapMutation(board, random);
             break;
         case BLOCK_SWAP:
-            blockSwapMutation(board);
+            blockSwapMutation(board, random);
             break;
         case RANDOM_CHANGE:
-            randomChangeMutation(board);
+            randomChangeMutation(board, random);
+            break;
+        case CONFLICT_CHANGE:
+            conflictChangeMutation(board, random);
+            break;
+        case CONFLICT_SWAP:
+            conflictSwapMutation(board, random);
             break;
         default:
-            rowSwapMutation(board);
+            rowSwapMutation(board, random);
     }
 }
 
-// Row swap mutation - swapping two numbers in a row
-void rowSwapMutation(SudokuBoard* board) {
-    // Select a random row
-    int row = rand() % BOARD_SIZE;
+const char* mutationName(MutationType type) {
+    switch(type) {
+        case ROW_SWAP: return "Row Swap";
+        case BLOCK_SWAP: return "Block Swap";
+        case RANDOM_CHANGE: return "Random Change";
+        case CONFLICT_CHANGE: return "Conflict Change";
+        case CONFLICT_SWAP: return "Conflict Swap";
+        case ADAPTIVE_MUTATION: return "Adaptive (bandit)";
+        default: return "Unknown";
+    }
+}
+
+// Pick two different positions out of count in constant time
+static void pickTwo(int count, int* first, int* second, RandomState* random) {
+    *first = randomInt(random, count);
+    *second = randomInt(random, count - 1);
+    if(*second >= *first) (*second)++;
+}
+
+static void swapCells(SudokuBoard* board, int cell1, int cell2) {
+    int* a = &board->board[cell1 / BOARD_SIZE][cell1 % BOARD_SIZE];
+    int* b = &board->board[cell2 / BOARD_SIZE][cell2 % BOARD_SIZE];
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
 
-    // Find two positions that are not fixed
-    int col1, col2;
-    do {
-        col1 = rand() % BOARD_SIZE;
-    } while(isFixed(board, row, col1));
+// Row swap mutation - swapping two numbers in a row
+void rowSwapMutation(SudokuBoard* board, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(board, &scratch);
 
-    do {
-        col2 = rand() % BOARD_SIZE;
-    } while(isFixed(board, row, col2) || col1 == col2);
+    // Only rows with two or more free cells can be mutated
+    if(index->swapRowCount == 0) return;
+    int row = index->swapRows[randomInt(random, index->swapRowCount)];
 
-    // Swap the numbers
-    int temp = board->board[row][col1];
-    board->board[row][col1] = board->board[row][col2];
-    board->board[row][col2] = temp;
+    int first, second;
+    pickTwo(index->rowCount[row], &first, &second, random);
+    swapCells(board, index->rowCells[row][first], index->rowCells[row][second]);
 
     calculateFitness(board);
 }
 
-// Block swap mutation - swapping two 3x3 blocks
-void blockSwapMutation(SudokuBoard* board) {
-    // Select two different blocks in the same row or column
-    int blockRow = rand() % 3;
-    int block1Col = rand() % 3;
-    int block2Col;
-    do {
-        block2Col = rand() % 3;
-    } while(block1Col == block2Col);
-
-    // Swap blocks (unblocked cells only)
-    for(int i = 0; i < BLOCK_SIZE; i++) {
-        for(int j = 0; j < BLOCK_SIZE; j++) {
-            int row = blockRow * BLOCK_SIZE + i;
-            int col1 = block1Col * BLOCK_SIZE + j;
-            int col2 = block2Col * BLOCK_SIZE + j;
-
-            if(!isFixed(board, row, col1) && !isFixed(board, row, col2)) {
-                int temp = board->board[row][col1];
-                board->board[row][col1] = board->board[row][col2];
-                board->board[row][col2] = temp;
-            }
-        }
+// Block swap mutation - swapping two 3x3 blocks of a band. Only positions
+// free in both blocks can be exchanged; the index lists them per pair.
+void blockSwapMutation(SudokuBoard* board, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(board, &scratch);
+
+    if(index->blockPairCount == 0) return;
+    int pair = randomInt(random, index->blockPairCount);
+
+    for(int i = 0; i < index->blockPairSize[pair]; i++) {
+        swapCells(board, index->blockPairCells[pair][i][0], index->blockPairCells[pair][i][1]);
     }
 
     calculateFitness(board);
 }
 
 // Random change mutation - changing a random number
-void randomChangeMutation(SudokuBoard* board) {
-    // Select a random item
-    int row, col;
-    do {
-        row = rand() % BOARD_SIZE;
-        col = rand() % BOARD_SIZE;
-    } while(isFixed(board, row, col));
-
-    // Select new random value
+void randomChangeMutation(SudokuBoard* board, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(board, &scratch);
+
+    // Select a random free item
+    if(index->freeCount == 0) return;
+    int cell = index->freeCells[randomInt(random, index->freeCount)];
+    int row = cell / BOARD_SIZE;
+    int col = cell % BOARD_SIZE;
+
+    // Select new random value - one of the eight other digits
     int oldValue = board->board[row][col];
-    int newValue;
-    do {
-        newValue = 1 + (rand() % 9);
-    } while(newValue == oldValue);
+    int newValue = (oldValue >= 1 && oldValue <= 9) ?
+                   1 + (oldValue + randomInt(random, 8)) % 9 :
+                   1 + randomInt(random, 9);
 
     board->board[row][col] = newValue;
     calculateFitness(board);
 }
 
+
+// === CONFLICT-DIRECTED MUTATIONS ===
+
+// Conflicts are read from the digit counts every board carries (see
+// calculateFitness()); the mutations change cells through setCell(), which
+// keeps those counts and the fitness current without a full evaluation.
+
+// Other cells holding the same digit in the row, column and block of a cell
+static int cellConflicts(SudokuBoard* board, int cell) {
+    int row = cell / BOARD_SIZE, col = cell % BOARD_SIZE;
+    int num = board->board[row][col];
+    if(num < 1 || num > 9) return 3;
+    return board->unitDigits[ROW_UNIT(row)][num] +
+           board->unitDigits[COLUMN_UNIT(col)][num] +
+           board->unitDigits[BLOCK_UNIT(row, col)][num] - 3;
+}
+
+// Conflicts a digit would have in a cell, not counting the cell itself
+static int digitConflicts(SudokuBoard* board, int cell, int num) {
+    int row = cell / BOARD_SIZE, col = cell % BOARD_SIZE;
+    return board->unitDigits[ROW_UNIT(row)][num] +
+           board->unitDigits[COLUMN_UNIT(col)][num] +
+           board->unitDigits[BLOCK_UNIT(row, col)][num];
+}
+
+// Pick a free cell with probability proportional to its conflicts;
+// returns -1 if no free cell conflicts
+static int pickConflictingCell(SudokuBoard* board, const PuzzleIndex* index, RandomState* random) {
+    int conflicts[BOARD_SIZE * BOARD_SIZE];
+    int total = 0;
+    for(int i = 0; i < index->freeCount; i++) {
+        conflicts[i] = cellConflicts(board, index->freeCells[i]);
+        total += conflicts[i];
+    }
+    if(total == 0) return -1;
+
+    int point = randomInt(random, total);
+    for(int i = 0; i < index->freeCount; i++) {
+        point -= conflicts[i];
+        if(point < 0) return index->freeCells[i];
+    }
+    return index->freeCells[index->freeCount - 1];
+}
+
+// Conflict change mutation - give a conflicting cell the digit with the
+// fewest conflicts (ties broken at random)
+void conflictChangeMutation(SudokuBoard* board, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(board, &scratch);
+    if(index->freeCount == 0) return;
+
+    int cell = pickConflictingCell(board, index, random);
+    if(cell < 0) return;  // Already a solution
+
+    int oldValue = board->board[cell / BOARD_SIZE][cell % BOARD_SIZE];
+    int bestValue = 0, bestConflicts = 0, ties = 0;
+    for(int num = 1; num <= 9; num++) {
+        if(num == oldValue) continue;
+        int conflicts = digitConflicts(board, cell, num);
+        if(bestValue == 0 || conflicts < bestConflicts) {
+            bestValue = num;
+            bestConflicts = conflicts;
+            ties = 1;
+        } else if(conflicts == bestConflicts && randomInt(random, ++ties) == 0) {
+            bestValue = num;
+        }
+    }
+
+    setCell(board, cell, bestValue);
+}
+
+// Conflict swap mutation - swap a conflicting cell with a free partner in
+// its row or block, preferring partners that conflict as well. Swaps keep
+// the digit counts of that unit, so a row or block permutation stays one.
+void conflictSwapMutation(SudokuBoard* board, RandomState* random) {
+    PuzzleIndex scratch;
+    const PuzzleIndex* index = boardPuzzleIndex(board, &scratch);
+    if(index->freeCount < 2) return;
+
+    int cell = pickConflictingCell(board, index, random);
+    if(cell < 0) return;
+
+    // Row or block at random; the other one if the first has no partner
+    int row = cell / BOARD_SIZE, col = cell % BOARD_SIZE;
+    int block = (row / BLOCK_SIZE) * BLOCK_SIZE + col / BLOCK_SIZE;
+    int useRow = randomInt(random, 2);
+    if(index->rowCount[row] < 2) useRow = 0;
+    if(index->blockCount[block] < 2) useRow = 1;
+    const unsigned char* unitCells = useRow ? index->rowCells[row] : index->blockCells[block];
+    int unitCount = useRow ? index->rowCount[row] : index->blockCount[block];
+    if(unitCount < 2) return;
+
+    int partners[BOARD_SIZE], conflicting[BOARD_SIZE];
+    int partnerCount = 0, conflictingCount = 0;
+    for(int i = 0; i < unitCount; i++) {
+        int other = unitCells[i];
+        if(other == cell) continue;
+        partners[partnerCount++] = other;
+        if(cellConflicts(board, other) > 0) conflicting[conflictingCount++] = other;
+    }
+
+    int partner = conflictingCount > 0 ? conflicting[randomInt(random, conflictingCount)]
+                                       : partners[randomInt(random, partnerCount)];
+    int value = board->board[row][col];
+    setCell(board, cell, board->board[partner / BOARD_SIZE][partner % BOARD_SIZE]);
+    setCell(board, partner, value);
+}
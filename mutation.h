@@ -4,9 +4,12 @@
 #include "sudoku.h"
 
 // Genetic operators - Mutation
-void mutate(SudokuBoard* board, MutationType type);
-void rowSwapMutation(SudokuBoard* board);
-void blockSwapMutation(SudokuBoard* board);
-void randomChangeMutation(SudokuBoard* board);
+void mutate(SudokuBoard* board, MutationType type, RandomState* random);
+void rowSwapMutation(SudokuBoard* board, RandomState* random);
+void blockSwapMutation(SudokuBoard* board, RandomState* random);
+void randomChangeMutation(SudokuBoard* board, RandomState* random);
+void conflictChangeMutation(SudokuBoard* board, RandomState* random);
+void conflictSwapMutation(SudokuBoard* board, RandomState* random);
+const char* mutationName(MutationType type);
 
 #endif
\ No newline at end of file
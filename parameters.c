@@ -0,0 +1,157 @@
+#include "parameters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sudoku.h"
+
+#define NAME_COUNT(names) ((int)(sizeof(names) / sizeof(names[0])))
+
+static const char* SELECTION_NAMES[] = {"TOURNAMENT", "ROULETTE", "RANKING"};
+static const char* CROSSOVER_NAMES[] = {"SINGLE_POINT", "MULTI_POINT", "UNIFORM", "ROW_CROSSOVER",
+                                        "BAND_CROSSOVER", "ADAPTIVE_CROSSOVER"};
+static const char* MUTATION_NAMES[] = {"ROW_SWAP", "BLOCK_SWAP", "RANDOM_CHANGE", "CONFLICT_CHANGE",
+                                       "CONFLICT_SWAP", "ADAPTIVE_MUTATION"};
+static const char* EVOLUTION_MODE_NAMES[] = {"GENERATIONAL", "STEADY_STATE"};
+static const char* REPLACEMENT_NAMES[] = {"REPLACE_WORST", "REPLACE_TOURNAMENT_LOSER"};
+
+void setDefaultParameters(GAParameters* parameters) {
+    GAParameters defaults = {
+        .populationSize = POPULATION_SIZE,
+        .maxGenerations = MAX_GENERATIONS,
+        .stagnationLimit = STAGNATION_LIMIT,
+        .crossoverRate = CROSSOVER_RATE,
+        .mutationRate = MUTATION_RATE,
+        .tournamentSize = TOURNAMENT_SIZE,
+        .eliteCount = ELITE_COUNT,
+        .adaptiveRates = ADAPTIVE_RATES,
+        .hybridFinisher = HYBRID_FINISHER,
+        .selection = TOURNAMENT,
+        .crossover = SINGLE_POINT,
+        .mutation = ROW_SWAP,
+        .evolutionMode = GENERATIONAL,
+        .replacement = REPLACE_WORST,
+        .steadyStateChildren = STEADY_STATE_CHILDREN,
+        .timeLimit = TIME_LIMIT,
+        .maxEvaluations = MAX_EVALUATIONS,
+        .targetFitness = TARGET_FITNESS,
+        .verbose = 1
+    };
+    *parameters = defaults;
+}
+
+// Find value in a name table; returns -1 if it is not there
+static int findName(const char* value, const char** names, int count) {
+    for(int i = 0; i < count; i++) {
+        if(strcmp(value, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// Keep parameters inside the ranges the solver supports. Applied to loaded
+// files and by the solver to whatever a library caller passes, so no value
+// can overrun the fixed-size tables of the engines; unknown operator or mode
+// values fall back to the defaults.
+void validateParameters(GAParameters* parameters) {
+    if(parameters->populationSize < 2) parameters->populationSize = 2;
+    if(parameters->populationSize > MAX_POPULATION_SIZE) parameters->populationSize = MAX_POPULATION_SIZE;
+    if(parameters->eliteCount < 0) parameters->eliteCount = 0;
+    if(parameters->eliteCount >= parameters->populationSize) parameters->eliteCount = parameters->populationSize - 1;
+    if(parameters->tournamentSize < 1) parameters->tournamentSize = 1;
+    if(parameters->maxGenerations < 1) parameters->maxGenerations = 1;
+    if(parameters->stagnationLimit < 1) parameters->stagnationLimit = 1;
+    if(!(parameters->crossoverRate >= 0.0)) parameters->crossoverRate = 0.0;
+    if(parameters->crossoverRate > 1.0) parameters->crossoverRate = 1.0;
+    if(!(parameters->mutationRate >= 0.0)) parameters->mutationRate = 0.0;
+    if(parameters->mutationRate > 1.0) parameters->mutationRate = 1.0;
+    if((unsigned)parameters->selection > RANKING) parameters->selection = TOURNAMENT;
+    if((unsigned)parameters->crossover > ADAPTIVE_CROSSOVER) parameters->crossover = SINGLE_POINT;
+    if((unsigned)parameters->mutation > ADAPTIVE_MUTATION) parameters->mutation = ROW_SWAP;
+    if((unsigned)parameters->evolutionMode > STEADY_STATE) parameters->evolutionMode = GENERATIONAL;
+    if((unsigned)parameters->replacement > REPLACE_TOURNAMENT_LOSER) parameters->replacement = REPLACE_WORST;
+    if(parameters->steadyStateChildren < 1) parameters->steadyStateChildren = 1;
+    if(parameters->steadyStateChildren > MAX_STEADY_STATE_CHILDREN) parameters->steadyStateChildren = MAX_STEADY_STATE_CHILDREN;
+    if(parameters->steadyStateChildren >= parameters->populationSize) parameters->steadyStateChildren = parameters->populationSize - 1;
+    if(!(parameters->timeLimit >= 0.0)) parameters->timeLimit = 0.0;
+    if(parameters->maxEvaluations < 0) parameters->maxEvaluations = 0;
+    if(parameters->targetFitness < 1 || parameters->targetFitness > 243) parameters->targetFitness = 243;
+}
+
+// Load "key = value" lines ('#' starts a comment); unknown keys are reported
+// and skipped. Returns 1 on success, 0 if the file cannot be read.
+int loadParameters(const char* path, GAParameters* parameters) {
+    FILE* file = fopen(path, "r");
+    if(!file) return 0;
+
+    char line[256];
+    int lineNumber = 0;
+    while(fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        line[strcspn(line, "#\r\n")] = 0;
+
+        char key[64], value[64];
+        int index;
+        if(sscanf(line, " %63[A-Za-z_] = %63s", key, value) != 2) continue;
+
+        if(strcmp(key, "population_size") == 0) parameters->populationSize = atoi(value);
+        else if(strcmp(key, "max_generations") == 0) parameters->maxGenerations = atoi(value);
+        else if(strcmp(key, "stagnation_limit") == 0) parameters->stagnationLimit = atoi(value);
+        else if(strcmp(key, "crossover_rate") == 0) parameters->crossoverRate = atof(value);
+        else if(strcmp(key, "mutation_rate") == 0) parameters->mutationRate = atof(value);
+        else if(strcmp(key, "tournament_size") == 0) parameters->tournamentSize = atoi(value);
+        else if(strcmp(key, "elite_count") == 0) parameters->eliteCount = atoi(value);
+        else if(strcmp(key, "adaptive_rates") == 0) parameters->adaptiveRates = atoi(value);
+        else if(strcmp(key, "hybrid_finisher") == 0) parameters->hybridFinisher = atoi(value);
+        else if(strcmp(key, "selection") == 0 &&
+                (index = findName(value, SELECTION_NAMES, NAME_COUNT(SELECTION_NAMES))) >= 0)
+            parameters->selection = (SelectionType)index;
+        else if(strcmp(key, "crossover") == 0 &&
+                (index = findName(value, CROSSOVER_NAMES, NAME_COUNT(CROSSOVER_NAMES))) >= 0)
+            parameters->crossover = (CrossoverType)index;
+        else if(strcmp(key, "mutation") == 0 &&
+                (index = findName(value, MUTATION_NAMES, NAME_COUNT(MUTATION_NAMES))) >= 0)
+            parameters->mutation = (MutationType)index;
+        else if(strcmp(key, "evolution_mode") == 0 &&
+                (index = findName(value, EVOLUTION_MODE_NAMES, NAME_COUNT(EVOLUTION_MODE_NAMES))) >= 0)
+            parameters->evolutionMode = (EvolutionMode)index;
+        else if(strcmp(key, "replacement") == 0 &&
+                (index = findName(value, REPLACEMENT_NAMES, NAME_COUNT(REPLACEMENT_NAMES))) >= 0)
+            parameters->replacement = (ReplacementPolicy)index;
+        else if(strcmp(key, "steady_state_children") == 0) parameters->steadyStateChildren = atoi(value);
+        else if(strcmp(key, "time_limit") == 0) parameters->timeLimit = atof(value);
+        else if(strcmp(key, "max_evaluations") == 0) parameters->maxEvaluations = atol(value);
+        else if(strcmp(key, "target_fitness") == 0) parameters->targetFitness = atoi(value);
+        else fprintf(stderr, "%s:%d: ignoring '%s = %s'\n", path, lineNumber, key, value);
+    }
+
+    fclose(file);
+    validateParameters(parameters);
+    return 1;
+}
+
+// Write parameters in the format read by loadParameters(); returns 1 on success
+int saveParameters(const char* path, const GAParameters* parameters) {
+    FILE* file = fopen(path, "w");
+    if(!file) return 0;
+
+    fprintf(file, "# Sudoku GA parameters\n");
+    fprintf(file, "population_size = %d\n", parameters->populationSize);
+    fprintf(file, "max_generations = %d\n", parameters->maxGenerations);
+    fprintf(file, "stagnation_limit = %d\n", parameters->stagnationLimit);
+    fprintf(file, "crossover_rate = %.3f\n", parameters->crossoverRate);
+    fprintf(file, "mutation_rate = %.3f\n", parameters->mutationRate);
+    fprintf(file, "tournament_size = %d\n", parameters->tournamentSize);
+    fprintf(file, "elite_count = %d\n", parameters->eliteCount);
+    fprintf(file, "adaptive_rates = %d\n", parameters->adaptiveRates);
+    fprintf(file, "hybrid_finisher = %d\n", parameters->hybridFinisher);
+    fprintf(file, "selection = %s\n", SELECTION_NAMES[parameters->selection]);
+    fprintf(file, "crossover = %s\n", CROSSOVER_NAMES[parameters->crossover]);
+    fprintf(file, "mutation = %s\n", MUTATION_NAMES[parameters->mutation]);
+    fprintf(file, "evolution_mode = %s\n", EVOLUTION_MODE_NAMES[parameters->evolutionMode]);
+    fprintf(file, "replacement = %s\n", REPLACEMENT_NAMES[parameters->replacement]);
+    fprintf(file, "steady_state_children = %d\n", parameters->steadyStateChildren);
+    fprintf(file, "time_limit = %.3f\n", parameters->timeLimit);
+    fprintf(file, "max_evaluations = %ld\n", parameters->maxEvaluations);
+    fprintf(file, "target_fitness = %d\n", parameters->targetFitness);
+
+    return fclose(file) == 0;
+}
@@ -0,0 +1,12 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include "sudoku.h"
+
+// Runtime parameters
+void setDefaultParameters(GAParameters* parameters);
+void validateParameters(GAParameters* parameters);
+int loadParameters(const char* path, GAParameters* parameters);
+int saveParameters(const char* path, const GAParameters* parameters);
+
+#endif
@@ -1,35 +1,68 @@
 #include "population.h"
-#include <stdio.h>
 #include <stdlib.h>
 #include "sudoku.h"
+#include "board_operations.h"
+#include "puzzle_index.h"
 
 
-// Create initial population
-Population* createPopulation(void) {
-    Population* population = (Population*)malloc(sizeof(Population));
-    if(!population) {
-        fprintf(stderr, "Failed to allocate population!\n");
-        exit(1);
-    }
+// Create initial population for the built-in puzzle
+Population* createPopulation(int size, RandomState* random) {
+    return createPopulationFromPuzzle(INITIAL_PUZZLE, size, random);
+}
 
-    population->size = POPULATION_SIZE;
-    population->boards = (SudokuBoard*)malloc(POPULATION_SIZE * sizeof(SudokuBoard));
-    if(!population->boards) {
-        fprintf(stderr, "Failed to allocate boards!\n");
-        free(population);
-        exit(1);
-    }
+// Create initial population for the given puzzle; NULL if it cannot be allocated
+Population* createPopulationFromPuzzle(const int puzzle[BOARD_SIZE][BOARD_SIZE], int size,
+                                       RandomState* random) {
+    Population* population = allocatePopulation(size);
+    if(population) resetPopulation(population, puzzle, random);
+    return population;
+}
 
-    for(int i = 0; i < POPULATION_SIZE; i++) {
-        initializeBoard(&population->boards[i]);
+// Allocate the buffers of a population without filling them, so a solver
+// can reuse them for every puzzle it solves. Returns NULL if size is outside
+// 2..MAX_POPULATION_SIZE or memory runs out.
+Population* allocatePopulation(int size) {
+    if(size < 2 || size > MAX_POPULATION_SIZE) return NULL;
+
+    Population* population = (Population*)calloc(1, sizeof(Population));
+    if(!population) return NULL;
+
+    population->size = size;
+    population->boards = (SudokuBoard*)malloc(size * sizeof(SudokuBoard));
+    population->spare = (SudokuBoard*)malloc(size * sizeof(SudokuBoard));
+    // Free-cell tables are built once per puzzle and shared by every board
+    population->index = (PuzzleIndex*)malloc(sizeof(PuzzleIndex));
+    population->diversity = (PopulationDiversity*)malloc(sizeof(PopulationDiversity));
+    population->nextDiversity = (PopulationDiversity*)malloc(sizeof(PopulationDiversity));
+    population->ranking = (FitnessOrder*)malloc(sizeof(FitnessOrder));
+    if(!population->boards || !population->spare || !population->index ||
+       !population->diversity || !population->nextDiversity || !population->ranking) {
+        destroyPopulation(population);
+        return NULL;
     }
 
     return population;
 }
 
+// Fill a population with random individuals for the given puzzle
+void resetPopulation(Population* population, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                     RandomState* random) {
+    buildPuzzleIndex(population->index, puzzle);
+
+    for(int i = 0; i < population->size; i++) {
+        initializeBoardFromPuzzle(&population->boards[i], puzzle, random);
+        population->boards[i].index = population->index;
+    }
+}
+
 void destroyPopulation(Population* population) {
     if(population) {
         free(population->boards);
+        free(population->spare);
+        free(population->index);
+        free(population->diversity);
+        free(population->nextDiversity);
+        free(population->ranking);
         free(population);
     }
 }
@@ -4,7 +4,12 @@
 #include "sudoku.h"
 
 // Population management
-Population* createPopulation(void);
+Population* createPopulation(int size, RandomState* random);
+Population* createPopulationFromPuzzle(const int puzzle[BOARD_SIZE][BOARD_SIZE], int size,
+                                       RandomState* random);
+Population* allocatePopulation(int size);
+void resetPopulation(Population* population, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                     RandomState* random);
 void destroyPopulation(Population* population);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "puzzle_index.h"
+#include <string.h>
+#include "sudoku.h"
+
+
+// === FREE-CELL INDEX TABLES ===
+
+// Build the tables for a puzzle - done once, shared by every board of a population
+void buildPuzzleIndex(PuzzleIndex* index, const int initial[BOARD_SIZE][BOARD_SIZE]) {
+    memset(index, 0, sizeof(PuzzleIndex));
+
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            if(initial[row][col] != 0) continue;
+
+            unsigned char cell = (unsigned char)(row * BOARD_SIZE + col);
+            int block = (row / BLOCK_SIZE) * BLOCK_SIZE + col / BLOCK_SIZE;
+            index->freeCells[index->freeCount++] = cell;
+            index->rowCells[row][index->rowCount[row]++] = cell;
+            index->colCells[col][index->colCount[col]++] = cell;
+            index->blockCells[block][index->blockCount[block]++] = cell;
+
+            unsigned int bit = 1u << (cell % 32);
+            index->freeMask.words[cell / 32] |= bit;
+            index->rowMasks[row].words[cell / 32] |= bit;
+            index->blockMasks[block].words[cell / 32] |= bit;
+            index->bandMasks[row / BLOCK_SIZE].words[cell / 32] |= bit;
+        }
+    }
+
+    // Units where a swap is possible (at least two free cells)
+    for(int unit = 0; unit < BOARD_SIZE; unit++) {
+        if(index->rowCount[unit] >= 2) index->swapRows[index->swapRowCount++] = (unsigned char)unit;
+        if(index->colCount[unit] >= 2) index->swapCols[index->swapColCount++] = (unsigned char)unit;
+        if(index->blockCount[unit] >= 2) index->swapBlocks[index->swapBlockCount++] = (unsigned char)unit;
+    }
+
+    // Pairs of blocks in the same band with at least one position free in both,
+    // together with those positions - the only ones a block swap can exchange
+    for(int band = 0; band < BLOCK_SIZE; band++) {
+        for(int first = 0; first < BLOCK_SIZE; first++) {
+            for(int second = first + 1; second < BLOCK_SIZE; second++) {
+                int pair = index->blockPairCount;
+                int size = 0;
+                for(int i = 0; i < BLOCK_SIZE; i++) {
+                    for(int j = 0; j < BLOCK_SIZE; j++) {
+                        int row = band * BLOCK_SIZE + i;
+                        int col1 = first * BLOCK_SIZE + j;
+                        int col2 = second * BLOCK_SIZE + j;
+                        if(initial[row][col1] != 0 || initial[row][col2] != 0) continue;
+
+                        index->blockPairCells[pair][size][0] = (unsigned char)(row * BOARD_SIZE + col1);
+                        index->blockPairCells[pair][size][1] = (unsigned char)(row * BOARD_SIZE + col2);
+                        size++;
+                    }
+                }
+                if(size > 0) {
+                    index->blockPairSize[pair] = (unsigned char)size;
+                    index->blockPairCount++;
+                }
+            }
+        }
+    }
+}
+
+// Tables of the board's puzzle; boards outside a population get them built into scratch
+const PuzzleIndex* boardPuzzleIndex(SudokuBoard* board, PuzzleIndex* scratch) {
+    if(board->index) return board->index;
+
+    buildPuzzleIndex(scratch, board->initial);
+    return scratch;
+}
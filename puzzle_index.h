@@ -0,0 +1,10 @@
+#ifndef PUZZLE_INDEX_H
+#define PUZZLE_INDEX_H
+
+#include "sudoku.h"
+
+// Free-cell index tables
+void buildPuzzleIndex(PuzzleIndex* index, const int initial[BOARD_SIZE][BOARD_SIZE]);
+const PuzzleIndex* boardPuzzleIndex(SudokuBoard* board, PuzzleIndex* scratch);
+
+#endif
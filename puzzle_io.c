@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L
+#include "puzzle_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sudoku.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+
+// Cell character -> value + 1; 0 marks characters that cannot be a cell
+static const unsigned char CELL_CODE[256] = {
+    ['.'] = 1, ['0'] = 1,
+    ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6,
+    ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10
+};
+
+// Block of every cell, row by row
+static const unsigned char CELL_BLOCK[CELL_COUNT] = {
+    0,0,0, 1,1,1, 2,2,2,  0,0,0, 1,1,1, 2,2,2,  0,0,0, 1,1,1, 2,2,2,
+    3,3,3, 4,4,4, 5,5,5,  3,3,3, 4,4,4, 5,5,5,  3,3,3, 4,4,4, 5,5,5,
+    6,6,6, 7,7,7, 8,8,8,  6,6,6, 7,7,7, 8,8,8,  6,6,6, 7,7,7, 8,8,8
+};
+
+
+// === PUZZLE CORPUS ===
+
+// Open a puzzle file: memory-mapped where supported, read into memory otherwise.
+// Returns 1 on success, 0 if the file cannot be read.
+int openCorpus(PuzzleCorpus* corpus, const char* path) {
+    memset(corpus, 0, sizeof(PuzzleCorpus));
+    corpus->validateClues = 1;
+
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return 0;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    corpus->length = (size_t)info.st_size;
+    if(corpus->length > 0) {
+        void* data = mmap(NULL, corpus->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data != MAP_FAILED) {
+            posix_madvise(data, corpus->length, POSIX_MADV_SEQUENTIAL);
+            corpus->data = (const char*)data;
+            corpus->mapped = 1;
+        }
+    }
+    close(fd);
+    if(corpus->length == 0 || corpus->mapped) return 1;
+#endif
+
+    // Fallback - read the whole file
+    FILE* file = fopen(path, "rb");
+    if(!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = size > 0 ? (char*)malloc((size_t)size) : NULL;
+    if(size > 0 && (!data || fread(data, 1, (size_t)size, file) != (size_t)size)) {
+        free(data);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+
+    corpus->data = data;
+    corpus->length = size > 0 ? (size_t)size : 0;
+    corpus->mapped = 0;
+    return 1;
+}
+
+// Read puzzles from a buffer owned by the caller
+void openCorpusBuffer(PuzzleCorpus* corpus, const char* data, size_t length) {
+    memset(corpus, 0, sizeof(PuzzleCorpus));
+    corpus->validateClues = 1;
+    corpus->data = data;
+    corpus->length = length;
+    corpus->mapped = -1;
+}
+
+// Parse 81 cell characters without branching per cell; returns 0 if any is invalid
+static int parseCells(const char* text, CompactPuzzle* puzzle) {
+    unsigned char invalid = 0;
+    for(int i = 0; i < CELL_COUNT; i++) {
+        unsigned char code = CELL_CODE[(unsigned char)text[i]];
+        invalid |= (unsigned char)(code == 0);
+        puzzle->cells[i] = (unsigned char)(code - 1);
+    }
+    return !invalid;
+}
+
+// Check that no clue repeats a digit in its row, column or block
+static int cluesConsistent(const CompactPuzzle* puzzle) {
+    unsigned rows[BOARD_SIZE] = {0}, cols[BOARD_SIZE] = {0}, blocks[BOARD_SIZE] = {0};
+    unsigned clash = 0;
+
+    for(int i = 0; i < CELL_COUNT; i++) {
+        unsigned bit = (1u << puzzle->cells[i]) & ~1u;  // Empty cells contribute nothing
+        int row = i / BOARD_SIZE, col = i % BOARD_SIZE, block = CELL_BLOCK[i];
+        clash |= (rows[row] | cols[col] | blocks[block]) & bit;
+        rows[row] |= bit;
+        cols[col] |= bit;
+        blocks[block] |= bit;
+    }
+
+    return clash == 0;
+}
+
+// Advance to the next physical line without looking at its contents: sets
+// corpus->line, lineLength (without the line break) and lineNumber. Only the
+// line boundary is searched for, so a reader can hand the parsing to other
+// threads (see parseLine()). Returns 0 at the end of the corpus.
+int nextRawLine(PuzzleCorpus* corpus) {
+    if(corpus->position >= corpus->length) return 0;
+
+    const char* line = corpus->data + corpus->position;
+    size_t remaining = corpus->length - corpus->position;
+    const char* end = (const char*)memchr(line, '\n', remaining);
+    size_t length = end ? (size_t)(end - line) : remaining;
+
+    corpus->position += length + (end ? 1 : 0);
+    corpus->lineNumber++;
+    corpus->line = line;
+    if(length > 0 && line[length - 1] == '\r') length--;
+    corpus->lineLength = length;
+    return 1;
+}
+
+// Classify one line and parse it into puzzle if it is a puzzle line: 81
+// cells ('.' or '0' for empty), anything after a separator ignored. With
+// validateClues, clues repeating a digit in a unit make the line malformed.
+// Touches nothing but its arguments, so any thread may call it.
+LineKind parseLine(const char* line, size_t length, int validateClues, CompactPuzzle* puzzle) {
+    if(length == 0 || line[0] == '#') return LINE_EMPTY;
+
+    int valid = length >= CELL_COUNT &&
+                (length == CELL_COUNT || CELL_CODE[(unsigned char)line[CELL_COUNT]] == 0) &&
+                parseCells(line, puzzle) &&
+                (!validateClues || cluesConsistent(puzzle));
+    return valid ? LINE_PUZZLE : LINE_MALFORMED;
+}
+
+// Read and parse the next physical line, whatever it holds (see
+// parseLine()); the line itself stays available in corpus->line. Malformed
+// lines are counted in invalidLines. Returns 1 and sets *kind if a line was
+// read, 0 at the end of the corpus.
+int nextLine(PuzzleCorpus* corpus, CompactPuzzle* puzzle, LineKind* kind) {
+    if(!nextRawLine(corpus)) return 0;
+
+    *kind = parseLine(corpus->line, corpus->lineLength, corpus->validateClues, puzzle);
+    if(*kind == LINE_MALFORMED) corpus->invalidLines++;
+    return 1;
+}
+
+// Parse the next puzzle, skipping blank, '#' and malformed lines.
+// Returns 1 if a puzzle was read, 0 at the end of the corpus.
+int nextPuzzle(PuzzleCorpus* corpus, CompactPuzzle* puzzle) {
+    LineKind kind;
+    while(nextLine(corpus, puzzle, &kind)) {
+        if(kind == LINE_PUZZLE) return 1;
+    }
+    return 0;
+}
+
+void closeCorpus(PuzzleCorpus* corpus) {
+#ifndef _WIN32
+    if(corpus->mapped == 1) munmap((void*)corpus->data, corpus->length);
+#endif
+    if(corpus->mapped == 0) free((void*)corpus->data);
+    memset(corpus, 0, sizeof(PuzzleCorpus));
+}
+
+void expandPuzzle(const CompactPuzzle* puzzle, int grid[BOARD_SIZE][BOARD_SIZE]) {
+    for(int i = 0; i < CELL_COUNT; i++) {
+        grid[i / BOARD_SIZE][i % BOARD_SIZE] = puzzle->cells[i];
+    }
+}
+
+void compactGrid(const int grid[BOARD_SIZE][BOARD_SIZE], CompactPuzzle* puzzle) {
+    for(int i = 0; i < CELL_COUNT; i++) {
+        puzzle->cells[i] = (unsigned char)grid[i / BOARD_SIZE][i % BOARD_SIZE];
+    }
+}
+
+
+// === RESULT WRITER ===
+
+static void flushResults(ResultWriter* writer) {
+    if(writer->used > 0) {
+        if(fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used) {
+            writer->failed = 1;
+        }
+        writer->used = 0;
+    }
+}
+
+// Open a buffered writer; "-" writes to stdout. Returns 1 on success.
+int openResultWriter(ResultWriter* writer, const char* path) {
+    memset(writer, 0, sizeof(ResultWriter));
+
+    writer->buffer = (char*)malloc(RESULT_BUFFER_SIZE);
+    if(!writer->buffer) return 0;
+
+    if(strcmp(path, "-") == 0) {
+        writer->file = stdout;
+    } else {
+        writer->file = fopen(path, "wb");
+        writer->ownsFile = 1;
+    }
+    if(!writer->file) {
+        free(writer->buffer);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Append a grid as one 81-character line ('.' for empty cells)
+void writeGrid(ResultWriter* writer, const int grid[BOARD_SIZE][BOARD_SIZE]) {
+    if(writer->used + CELL_COUNT + 1 > RESULT_BUFFER_SIZE) flushResults(writer);
+
+    char* out = writer->buffer + writer->used;
+    for(int i = 0; i < CELL_COUNT; i++) {
+        int num = grid[i / BOARD_SIZE][i % BOARD_SIZE];
+        out[i] = num >= 1 && num <= 9 ? (char)('0' + num) : '.';
+    }
+    out[CELL_COUNT] = '\n';
+    writer->used += CELL_COUNT + 1;
+}
+
+void writeText(ResultWriter* writer, const char* text, size_t length) {
+    if(writer->used + length > RESULT_BUFFER_SIZE) flushResults(writer);
+    if(length > RESULT_BUFFER_SIZE) {
+        if(fwrite(text, 1, length, writer->file) != length) writer->failed = 1;
+        return;
+    }
+    memcpy(writer->buffer + writer->used, text, length);
+    writer->used += length;
+}
+
+// Flush and close; returns 1 if everything was written
+int closeResultWriter(ResultWriter* writer) {
+    flushResults(writer);
+    if(fflush(writer->file) != 0) writer->failed = 1;
+    if(writer->ownsFile && fclose(writer->file) != 0) writer->failed = 1;
+    free(writer->buffer);
+
+    int ok = !writer->failed;
+    memset(writer, 0, sizeof(ResultWriter));
+    return ok;
+}
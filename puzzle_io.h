@@ -0,0 +1,22 @@
+#ifndef PUZZLE_IO_H
+#define PUZZLE_IO_H
+
+#include "sudoku.h"
+
+// Puzzle corpus reading and result writing
+int openCorpus(PuzzleCorpus* corpus, const char* path);
+void openCorpusBuffer(PuzzleCorpus* corpus, const char* data, size_t length);
+int nextPuzzle(PuzzleCorpus* corpus, CompactPuzzle* puzzle);
+int nextLine(PuzzleCorpus* corpus, CompactPuzzle* puzzle, LineKind* kind);
+int nextRawLine(PuzzleCorpus* corpus);
+LineKind parseLine(const char* line, size_t length, int validateClues, CompactPuzzle* puzzle);
+void closeCorpus(PuzzleCorpus* corpus);
+void expandPuzzle(const CompactPuzzle* puzzle, int grid[BOARD_SIZE][BOARD_SIZE]);
+void compactGrid(const int grid[BOARD_SIZE][BOARD_SIZE], CompactPuzzle* puzzle);
+
+int openResultWriter(ResultWriter* writer, const char* path);
+void writeGrid(ResultWriter* writer, const int grid[BOARD_SIZE][BOARD_SIZE]);
+void writeText(ResultWriter* writer, const char* text, size_t length);
+int closeResultWriter(ResultWriter* writer);
+
+#endif
@@ -0,0 +1,36 @@
+#include "rng.h"
+#include "sudoku.h"
+
+// Spread a seed over all 64 bits (splitmix64), so similar seeds give unrelated streams
+void seedRandom(RandomState* random, unsigned long long seed) {
+    unsigned long long z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    random->state = z ? z : 0x9E3779B97F4A7C15ULL;  // xorshift must not start at 0
+}
+
+// xorshift64* step
+static unsigned long long nextRandom(RandomState* random) {
+    unsigned long long x = random->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    random->state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform integer in 0..bound-1 (multiply-shift instead of a division)
+int randomInt(RandomState* random, int bound) {
+    return (int)(((nextRandom(random) >> 32) * (unsigned long long)bound) >> 32);
+}
+
+// 32 random bits
+unsigned int randomWord(RandomState* random) {
+    return (unsigned int)(nextRandom(random) >> 32);
+}
+
+// Uniform double in [0, 1)
+double randomUnit(RandomState* random) {
+    return (nextRandom(random) >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,13 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include "sudoku.h"
+
+// Random numbers - every caller passes the generator it owns, so threads
+// never share random state
+void seedRandom(RandomState* random, unsigned long long seed);
+int randomInt(RandomState* random, int bound);
+unsigned int randomWord(RandomState* random);
+double randomUnit(RandomState* random);
+
+#endif
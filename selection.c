@@ -2,39 +2,59 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "sudoku.h"
+#include "rng.h"
 
 // === SELECTION OPERATORS ===
 
-SudokuBoard selectParent(Population* population, SelectionType type) {
+SudokuBoard selectParent(Population* population, SelectionType type, int tournamentSize,
+                         RandomState* random) {
+    return population->boards[selectParentIndex(population, type, tournamentSize, random)];
+}
+
+// Same as selectParent, but returns the position instead of a copy of the board
+int selectParentIndex(Population* population, SelectionType type, int tournamentSize,
+                      RandomState* random) {
     switch(type) {
         case TOURNAMENT:
-            return tournamentSelection(population, TOURNAMENT_SIZE);
+            return tournamentSelectionIndex(population, tournamentSize, random);
         case ROULETTE:
-            return rouletteSelection(population);
+            return rouletteSelectionIndex(population, random);
         case RANKING:
-            return rankingSelection(population);
+            return rankingSelectionIndex(population, random);
         default:
-            return tournamentSelection(population, TOURNAMENT_SIZE);
+            return tournamentSelectionIndex(population, tournamentSize, random);
     }
 }
 
+SudokuBoard tournamentSelection(Population* population, int tournamentSize, RandomState* random) {
+    return population->boards[tournamentSelectionIndex(population, tournamentSize, random)];
+}
+
+SudokuBoard rouletteSelection(Population* population, RandomState* random) {
+    return population->boards[rouletteSelectionIndex(population, random)];
+}
+
+SudokuBoard rankingSelection(Population* population, RandomState* random) {
+    return population->boards[rankingSelectionIndex(population, random)];
+}
+
 // Tournament selection - selects the best from a random group
-SudokuBoard tournamentSelection(Population* population, int tournamentSize) {
-    int bestIndex = rand() % population->size;
+int tournamentSelectionIndex(Population* population, int tournamentSize, RandomState* random) {
+    int bestIndex = randomInt(random, population->size);
 
     for(int i = 1; i < tournamentSize; i++) {
-        int randomIndex = rand() % population->size;
+        int randomIndex = randomInt(random, population->size);
         if(population->boards[randomIndex].fitness >
            population->boards[bestIndex].fitness) {
             bestIndex = randomIndex;
         }
     }
 
-    return population->boards[bestIndex];
+    return bestIndex;
 }
 
 // Roulette selection - probability proportional to fitness
-SudokuBoard rouletteSelection(Population* population) {
+int rouletteSelectionIndex(Population* population, RandomState* random) {
     // Find the smallest fitness (to shift all values to positive)
     int minFitness = population->boards[0].fitness;
     for(int i = 1; i < population->size; i++) {
@@ -50,24 +70,24 @@ SudokuBoard rouletteSelection(Population* population) {
     }
 
     // Select a random point
-    long point = rand() % totalFitness;
+    long point = randomInt(random, (int)totalFitness);
     long sum = 0;
 
     //  Find a suitable individual
     for(int i = 0; i < population->size; i++) {
         sum += (population->boards[i].fitness - minFitness + 1);
         if(sum > point) {
-            return population->boards[i];
+            return i;
         }
     }
 
-    return population->boards[population->size - 1];
+    return population->size - 1;
 }
 
 // Ranking selection - the probability depends on the position in the ranking
-SudokuBoard rankingSelection(Population* population) {
+int rankingSelectionIndex(Population* population, RandomState* random) {
     // Create an index table
-    int indices[POPULATION_SIZE];
+    int indices[MAX_POPULATION_SIZE];
     for(int i = 0; i < population->size; i++) indices[i] = i;
 
     // Sort indexes by fitness (bubble sort)
@@ -84,15 +104,15 @@ SudokuBoard rankingSelection(Population* population) {
 
     // Select by rank
     int totalRank = (population->size * (population->size + 1)) / 2;
-    int point = rand() % totalRank;
+    int point = randomInt(random, totalRank);
     int sum = 0;
 
     for(int i = 0; i < population->size; i++) {
         sum += (population->size - i);
         if(sum > point) {
-            return population->boards[indices[i]];
+            return indices[i];
         }
     }
 
-    return population->boards[indices[0]];
+    return indices[0];
 }
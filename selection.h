@@ -4,9 +4,15 @@
 #include "sudoku.h"
 
 // Genetic operators - Selection
-SudokuBoard selectParent(Population* population, SelectionType type);
-SudokuBoard tournamentSelection(Population* population, int tournamentSize);
-SudokuBoard rouletteSelection(Population* population);
-SudokuBoard rankingSelection(Population* population);
+SudokuBoard selectParent(Population* population, SelectionType type, int tournamentSize,
+                         RandomState* random);
+SudokuBoard tournamentSelection(Population* population, int tournamentSize, RandomState* random);
+SudokuBoard rouletteSelection(Population* population, RandomState* random);
+SudokuBoard rankingSelection(Population* population, RandomState* random);
+int selectParentIndex(Population* population, SelectionType type, int tournamentSize,
+                      RandomState* random);
+int tournamentSelectionIndex(Population* population, int tournamentSize, RandomState* random);
+int rouletteSelectionIndex(Population* population, RandomState* random);
+int rankingSelectionIndex(Population* population, RandomState* random);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "solver.h"
+#include <stdlib.h>
+#include "sudoku.h"
+#include "parameters.h"
+#include "population.h"
+#include "evolution.h"
+#include "rng.h"
+
+// Everything one solve needs. Contexts share no mutable state, so any number
+// of them can solve concurrently on different threads.
+struct SudokuSolver {
+    GAParameters parameters;
+    RandomState random;
+    EventLog* log;              // Not owned; may be shared between solvers
+    SolverCallback callback;
+    void* callbackData;
+    SolverProgress progress;
+    Population* population;     // Buffers reused by every solve
+};
+
+
+// === SOLVER CONTEXT ===
+
+// Create a solver; NULL parameters means the compile-time defaults. The
+// parameters are validated like a loaded file. Returns NULL if memory runs out.
+SudokuSolver* createSolver(const GAParameters* parameters) {
+    SudokuSolver* solver = (SudokuSolver*)calloc(1, sizeof(SudokuSolver));
+    if(!solver) return NULL;
+
+    if(parameters) solver->parameters = *parameters;
+    else setDefaultParameters(&solver->parameters);
+    validateParameters(&solver->parameters);
+    seedRandom(&solver->random, 1);
+    atomic_init(&solver->progress.generation, 0);
+    atomic_init(&solver->progress.bestFitness, 0);
+    atomic_init(&solver->progress.improvements, 0);
+    atomic_init(&solver->progress.cancelRequested, 0);
+    solver->population = allocatePopulation(solver->parameters.populationSize);
+    if(!solver->population) {
+        free(solver);
+        return NULL;
+    }
+    return solver;
+}
+
+void destroySolver(SudokuSolver* solver) {
+    if(solver) {
+        destroyPopulation(solver->population);
+        free(solver);
+    }
+}
+
+// Replace the parameters (not while the solver is solving); they are
+// validated like a loaded file. Returns 0 and keeps the old parameters if
+// the buffers for a new population size cannot be allocated.
+int setSolverParameters(SudokuSolver* solver, const GAParameters* parameters) {
+    GAParameters validated = *parameters;
+    validateParameters(&validated);
+
+    if(solver->population->size != validated.populationSize) {
+        Population* population = allocatePopulation(validated.populationSize);
+        if(!population) return 0;
+        destroyPopulation(solver->population);
+        solver->population = population;
+    }
+    solver->parameters = validated;
+    return 1;
+}
+
+const GAParameters* getSolverParameters(SudokuSolver* solver) {
+    return &solver->parameters;
+}
+
+// Same seed, parameters and puzzle give the same result
+void setSolverSeed(SudokuSolver* solver, unsigned long long seed) {
+    seedRandom(&solver->random, seed);
+}
+
+void setSolverLog(SudokuSolver* solver, EventLog* log) {
+    solver->log = log;
+}
+
+void setSolverCallback(SudokuSolver* solver, SolverCallback callback, void* userData) {
+    solver->callback = callback;
+    solver->callbackData = userData;
+}
+
+// Progress of the running solve - may be read from any thread
+const SolverProgress* getSolverProgress(SudokuSolver* solver) {
+    return &solver->progress;
+}
+
+// Ask a running solve to stop - may be called from any thread. The solve
+// returns its best board so far with STOP_CANCELLED. A request made while no
+// solve is running is dropped when the next solve starts.
+void cancelSolve(SudokuSolver* solver) {
+    atomic_store(&solver->progress.cancelRequested, 1);
+}
+
+// Solve a puzzle (0 = empty cell) with the solver's parameters. Everything
+// the solve uses is reached through the solver, so concurrent solves on
+// different solvers never touch shared state.
+SolveResult solve(SudokuSolver* solver, const int puzzle[BOARD_SIZE][BOARD_SIZE]) {
+    SolveState state;
+    state.parameters = &solver->parameters;
+    state.random = &solver->random;
+    state.log = solver->log;
+    state.callback = solver->callback;
+    state.callbackData = solver->callbackData;
+    state.progress = &solver->progress;
+    state.evaluations = 0;
+
+    // A cancel request ends only the solve it was made for - a late one that
+    // arrived after the previous solve returned must not stop this one
+    atomic_store(&solver->progress.cancelRequested, 0);
+    resetPopulation(solver->population, puzzle, &solver->random);
+    SolveResult result = evolve(&state, solver->population, solver->parameters.selection,
+                                solver->parameters.crossover, solver->parameters.mutation);
+    return result;
+}
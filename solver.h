@@ -0,0 +1,18 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "sudoku.h"
+
+// Solver contexts - reentrant library interface
+SudokuSolver* createSolver(const GAParameters* parameters);
+void destroySolver(SudokuSolver* solver);
+int setSolverParameters(SudokuSolver* solver, const GAParameters* parameters);
+const GAParameters* getSolverParameters(SudokuSolver* solver);
+void setSolverSeed(SudokuSolver* solver, unsigned long long seed);
+void setSolverLog(SudokuSolver* solver, EventLog* log);
+void setSolverCallback(SudokuSolver* solver, SolverCallback callback, void* userData);
+const SolverProgress* getSolverProgress(SudokuSolver* solver);
+void cancelSolve(SudokuSolver* solver);
+SolveResult solve(SudokuSolver* solver, const int puzzle[BOARD_SIZE][BOARD_SIZE]);
+
+#endif
@@ -0,0 +1,204 @@
+#include "steady_state.h"
+#include <string.h>
+#include "sudoku.h"
+#include "evolution.h"
+#include "event_log.h"
+#include "budget.h"
+#include "rng.h"
+
+static void buildOrder(FitnessOrder* ranking, Population* population) {
+    for(int i = 0; i < population->size; i++) ranking->order[i] = i;
+
+    // Insertion sort - done once per run
+    for(int i = 1; i < population->size; i++) {
+        int current = ranking->order[i];
+        int fitness = population->boards[current].fitness;
+        int j = i - 1;
+        while(j >= 0 && population->boards[ranking->order[j]].fitness < fitness) {
+            ranking->order[j + 1] = ranking->order[j];
+            j--;
+        }
+        ranking->order[j + 1] = current;
+    }
+
+    for(int i = 0; i < population->size; i++) ranking->rankOf[ranking->order[i]] = i;
+}
+
+// Move a board whose fitness changed to its new rank: binary search for the
+// position among the others, then shift the ranks in between by one
+static void reposition(FitnessOrder* ranking, Population* population, int boardIdx) {
+    int size = population->size;
+    int fitness = population->boards[boardIdx].fitness;
+    int from = ranking->rankOf[boardIdx];
+
+    // Take the board out of the order
+    memmove(&ranking->order[from], &ranking->order[from + 1], (size - from - 1) * sizeof(int));
+
+    // First rank among the remaining boards with a lower fitness (ties stay ahead,
+    // so a new board goes behind equally fit older ones)
+    int low = 0, high = size - 1;
+    while(low < high) {
+        int mid = (low + high) / 2;
+        if(population->boards[ranking->order[mid]].fitness >= fitness) low = mid + 1;
+        else high = mid;
+    }
+
+    memmove(&ranking->order[low + 1], &ranking->order[low], (size - 1 - low) * sizeof(int));
+    ranking->order[low] = boardIdx;
+
+    int first = from < low ? from : low;
+    int last = from > low ? from : low;
+    for(int i = first; i <= last; i++) ranking->rankOf[ranking->order[i]] = i;
+}
+
+// Ranking selection straight from the maintained order - no sorting per pick
+static int rankedParentIndex(FitnessOrder* ranking, int size, RandomState* random) {
+    int totalRank = (size * (size + 1)) / 2;
+    int point = randomInt(random, totalRank);
+    int sum = 0;
+
+    for(int i = 0; i < size; i++) {
+        sum += (size - i);
+        if(sum > point) return ranking->order[i];
+    }
+
+    return ranking->order[0];
+}
+
+// Board to be replaced; the current best (rank 0) is never chosen
+static int chooseVictim(FitnessOrder* ranking, Population* population, const SolveState* state) {
+    if(state->parameters->replacement == REPLACE_TOURNAMENT_LOSER) {
+        // Reverse tournament among ranks 1..size-1 - the worst one loses
+        int worstRank = 1 + randomInt(state->random, population->size - 1);
+        for(int i = 1; i < state->parameters->tournamentSize; i++) {
+            int rank = 1 + randomInt(state->random, population->size - 1);
+            if(rank > worstRank) worstRank = rank;
+        }
+        return ranking->order[worstRank];
+    }
+
+    return ranking->order[population->size - 1];
+}
+
+
+// === STEADY-STATE EVOLUTION ===
+
+// Each step breeds parameters->steadyStateChildren children and inserts
+// each one in place of a victim it is at least as fit as. One generation
+// equivalent is populationSize / steadyStateChildren steps; generation
+// limits, stagnation and rate adaptation are counted in those units, while
+// the solve budget (target, cancellation, deadline, evaluations) is checked
+// after every step.
+SolveResult evolveSteadyState(SolveState* state, Population* population,
+                              SelectionType selType,
+                              CrossoverType crossType,
+                              MutationType mutType) {
+    const GAParameters* parameters = state->parameters;
+    int size = population->size;
+    // Bounded here as well as by validateParameters(): children[] is fixed-size
+    int childCount = parameters->steadyStateChildren;
+    if(childCount > MAX_STEADY_STATE_CHILDREN) childCount = MAX_STEADY_STATE_CHILDREN;
+    if(childCount > size - 1) childCount = size - 1;
+    if(childCount < 1) childCount = 1;
+    int stepsPerGeneration = size / childCount;
+    if(stepsPerGeneration < 1) stepsPerGeneration = 1;
+
+    SolveBudget budget;
+    startBudget(&budget, state);
+
+    // Bookkeeping lives with the population
+    FitnessOrder* ranking = population->ranking;
+    PopulationDiversity* diversity = population->diversity;
+    buildOrder(ranking, population);
+
+    BreedingState breeding;
+    initBreeding(state, &breeding);
+
+    // Statistics are updated as boards are replaced, never rebuilt
+    resetDiversity(diversity, &population->boards[0]);
+    for(int i = 0; i < size; i++) {
+        addToDiversity(diversity, &population->boards[i]);
+    }
+    computeDiversity(diversity);
+    if(parameters->adaptiveRates) adaptRates(diversity, parameters, &breeding.crossoverRate, &breeding.mutationRate);
+
+    int bestFitness = population->boards[ranking->order[0]].fitness;
+    reportEvolutionStart(state, bestFitness);
+
+    SudokuBoard children[MAX_STEADY_STATE_CHILDREN];
+    int generationsWithoutImprovement = 0;
+    int totalImprovements = 0;
+    int improvedThisGeneration = 0;
+    int gen = 0;
+    int step = 0;
+    StopReason reason = checkBudget(&budget, state, bestFitness);
+
+    while(reason == STOP_NONE) {
+        if(gen >= parameters->maxGenerations) {
+            reason = STOP_MAX_GENERATIONS;
+            break;
+        }
+
+        // Breed all children of the step from the current population first;
+        // a step ends early once the evaluation limit is used up
+        int bred = 0;
+        while(bred < childCount) {
+            int parent1, parent2;
+            if(selType == RANKING) {
+                parent1 = rankedParentIndex(ranking, size, state->random);
+                parent2 = rankedParentIndex(ranking, size, state->random);
+            } else {
+                parent1 = selectParentIndex(population, selType, parameters->tournamentSize, state->random);
+                parent2 = selectParentIndex(population, selType, parameters->tournamentSize, state->random);
+            }
+            breedChild(state, &population->boards[parent1], &population->boards[parent2],
+                       &children[bred++], crossType, mutType, &breeding, &budget);
+            if(!evaluationsLeft(&budget, state)) break;
+        }
+
+        // Then insert them in place of their victims
+        for(int c = 0; c < bred; c++) {
+            int victim = chooseVictim(ranking, population, state);
+            if(children[c].fitness < population->boards[victim].fitness) continue;
+
+            removeFromDiversity(diversity, &population->boards[victim]);
+            copyBoard(&children[c], &population->boards[victim]);
+            addToDiversity(diversity, &population->boards[victim]);
+            reposition(ranking, population, victim);
+        }
+
+        int currentBest = population->boards[ranking->order[0]].fitness;
+        if(currentBest > bestFitness) {
+            bestFitness = currentBest;
+            totalImprovements++;
+            improvedThisGeneration = 1;
+            reportImprovement(state, gen, totalImprovements, bestFitness, diversity, &breeding);
+        }
+        reason = checkBudget(&budget, state, bestFitness);
+
+        // Generation equivalent completed
+        if(++step == stepsPerGeneration) {
+            step = 0;
+            gen++;
+            computeDiversity(diversity);
+            if(parameters->adaptiveRates) adaptRates(diversity, parameters, &breeding.crossoverRate, &breeding.mutationRate);
+
+            if(state->progress) atomic_store_explicit(&state->progress->generation, gen, memory_order_relaxed);
+            if(parameters->verbose) {
+                solverEvent(state, EVENT_DEBUG, EVENT_GENERATION, gen - 1, bestFitness, NULL);
+            }
+
+            if(improvedThisGeneration) {
+                generationsWithoutImprovement = 0;
+            } else if(++generationsWithoutImprovement >= parameters->stagnationLimit &&
+                      reason == STOP_NONE) {
+                reason = STOP_STAGNATION;
+            }
+            improvedThisGeneration = 0;
+        }
+    }
+
+    SudokuBoard best;
+    copyBoard(&population->boards[ranking->order[0]], &best);
+    return finishEvolution(state, &best, gen, reason, &budget, crossType, mutType, &breeding);
+}
@@ -0,0 +1,12 @@
+#ifndef STEADY_STATE_H
+#define STEADY_STATE_H
+
+#include "sudoku.h"
+
+// Steady-state evolution - children replace members of the population in place
+SolveResult evolveSteadyState(SolveState* state, Population* population,
+                              SelectionType selType,
+                              CrossoverType crossType,
+                              MutationType mutType);
+
+#endif
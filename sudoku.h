@@ -1,19 +1,76 @@
 #ifndef ALGORYTMGENETYCZNYSUDOKU_SUDOKU_H
 #define ALGORYTMGENETYCZNYSUDOKU_SUDOKU_H
 
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+
 // Board configuration
 #define BOARD_SIZE 9        // Size of Sudoku board (9x9)
 #define BLOCK_SIZE 3        // Size of 3x3 blocks
 #define POPULATION_SIZE 200 // Number of individuals in population
+#define MAX_POPULATION_SIZE 2000 // Upper bound for a runtime population size
 
 // Genetic Algorithm parameters
 #define MAX_GENERATIONS 1000
+#define STAGNATION_LIMIT 300     // Generations without improvement before giving up
 #define CROSSOVER_RATE 0.9
 #define MUTATION_PROBABILITY 0.05
 #define MUTATION_RATE 0.2
 #define TOURNAMENT_SIZE 10
 #define ELITE_COUNT 8       // Number of best individuals to preserve
 
+// Adaptive rates (CROSSOVER_RATE and MUTATION_RATE are the rates at healthy diversity)
+#define ADAPTIVE_RATES 1         // Adapt rates to population diversity each generation
+#define CROSSOVER_RATE_MIN 0.6   // Crossover rate of a population with no diversity left
+#define MUTATION_RATE_MAX 0.6    // Mutation rate of a population with no diversity left
+#define DIVERSITY_TARGET 0.25    // Mean Hamming distance (per free cell) considered healthy
+#define ENTROPY_TARGET 0.2       // Mean value entropy (per free cell) considered healthy
+
+// Hybrid finisher: complete the best GA individual with the exact solver
+// when evolution stops without a perfect solution
+#define HYBRID_FINISHER 1
+
+// Adaptive operator selection (ADAPTIVE_CROSSOVER / ADAPTIVE_MUTATION)
+#define MAX_BANDIT_ARMS 16
+#define BANDIT_EXPLORATION 0.5   // Weight of the UCB exploration term
+#define BANDIT_DISCOUNT 0.999    // Per-pull decay of older operator statistics
+#define BANDIT_TIMING_INTERVAL 16 // Time one pull in this many per arm; the rest are charged its mean cost
+
+// Steady-state evolution (EvolutionMode STEADY_STATE)
+#define STEADY_STATE_CHILDREN 2  // Children bred and inserted per step
+#define MAX_STEADY_STATE_CHILDREN 16
+
+// Solve budgets (0 disables a limit)
+#define TIME_LIMIT 0.0           // Wall-clock seconds per solve
+#define MAX_EVALUATIONS 0        // Fitness evaluations per solve
+#define TARGET_FITNESS 243       // Stop once the best individual reaches this fitness
+
+// Puzzle input/output
+#define RESULT_BUFFER_SIZE (1 << 20) // Bytes collected before a result batch is written
+#define MAX_WORKER_THREADS 64        // Upper bound for --threads
+
+// Bulk verification - diagnostic word of one solution (0 = valid)
+#define VERIFY_CHUNK (1 << 16)       // Solutions read and checked per parallel round
+#define VERIFY_ROW_SHIFT 0           // Bits 0-8: rows that do not hold 1..9
+#define VERIFY_COLUMN_SHIFT 9        // Bits 9-17: columns
+#define VERIFY_BLOCK_SHIFT 18        // Bits 18-26: blocks
+#define VERIFY_UNIT_MASK 0x1FFu      // Nine units of one kind
+#define VERIFY_CLUE_MISMATCH (1u << 27) // A clue of the puzzle was changed
+#define VERIFY_BAD_PUZZLE (1u << 28)    // Puzzle line missing or malformed - nothing was checked
+#define VERIFY_BAD_SOLUTION (1u << 29)  // Solution line missing or malformed
+
+// Puzzle generator
+#define GENERATOR_MIN_CLUES 0        // Stop removing clues at this count (0 = minimal puzzle)
+#define RATING_FITNESS 232           // Rating = evaluations until the GA first reaches this fitness
+#define RATING_MAX_EVALUATIONS 25000 // Rating budget - puzzles that need more are marked '+'
+
+// Event log and interactive progress
+#define EVENT_QUEUE_CAPACITY 4096    // Ring buffer slots (power of two)
+#define EVENT_MESSAGE_SIZE 160
+#define EVENT_DRAIN_INTERVAL_MS 5    // Drain thread pause when the buffer is empty
+#define UI_REFRESH_MS 100            // Progress redraw interval of the interactive front end
+
 // Selection types
 typedef enum {
     TOURNAMENT,  // Tournament selection
@@ -25,32 +82,330 @@ typedef enum {
 typedef enum {
     SINGLE_POINT,    // Single point crossover (3x3 block exchange)
     MULTI_POINT,     // Multi point crossover (multiple blocks)
-    UNIFORM         // Uniform crossover
+    UNIFORM,        // Uniform crossover
+    ROW_CROSSOVER,  // Random subset of rows
+    BAND_CROSSOVER, // One band of three blocks
+    ADAPTIVE_CROSSOVER // Bandit picks one of the above per offspring (keep last)
 } CrossoverType;
 
 // Mutation types
 typedef enum {
     ROW_SWAP,       // Swap numbers in a row
     BLOCK_SWAP,     // Swap 3x3 blocks
-    RANDOM_CHANGE   // Change single random number
+    RANDOM_CHANGE,  // Change single random number
+    CONFLICT_CHANGE, // Give a conflicting number the least conflicting digit
+    CONFLICT_SWAP,  // Swap a conflicting number within its row or block
+    ADAPTIVE_MUTATION // Bandit picks one of the above per offspring (keep last)
 } MutationType;
 
+// Evolution modes
+typedef enum {
+    GENERATIONAL,  // Whole population replaced every generation
+    STEADY_STATE   // A few children replace members in place every step
+} EvolutionMode;
+
+// Steady-state replacement policies
+typedef enum {
+    REPLACE_WORST,            // Child replaces the worst individual
+    REPLACE_TOURNAMENT_LOSER  // Child replaces the loser of a reverse tournament
+} ReplacementPolicy;
+
+// Event levels
+typedef enum {
+    EVENT_DEBUG,
+    EVENT_INFO,
+    EVENT_WARNING
+} EventLevel;
+
+// Event output formats
+typedef enum {
+    EVENT_FORMAT_PLAIN,
+    EVENT_FORMAT_JSON
+} EventFormat;
+
+// Kinds of solver events
+typedef enum {
+    EVENT_START,
+    EVENT_GENERATION,
+    EVENT_IMPROVEMENT,
+    EVENT_STAGNATION,
+    EVENT_SOLVED,
+    EVENT_FINISHER,
+    EVENT_OPERATORS,
+    EVENT_CANCELLED,
+    EVENT_BUDGET,
+    EVENT_END
+} EventKind;
+
+// What a physical line of a puzzle file holds
+typedef enum {
+    LINE_PUZZLE,     // 81 valid cells (anything after a separator is ignored)
+    LINE_EMPTY,      // Blank line or '#' comment
+    LINE_MALFORMED   // Anything else, or clues that repeat a digit in a unit
+} LineKind;
+
+// Why a solve stopped
+typedef enum {
+    STOP_NONE,             // Still running
+    STOP_SOLVED,
+    STOP_TARGET_REACHED,   // Target fitness below 243 reached
+    STOP_MAX_GENERATIONS,
+    STOP_STAGNATION,
+    STOP_TIME_LIMIT,
+    STOP_EVALUATION_LIMIT,
+    STOP_CANCELLED
+} StopReason;
+
+// Asynchronous event log (lock-free ring buffer drained by its own thread)
+typedef struct EventLog EventLog;
+
+// Solver context - puzzle buffers, parameters, random state, log and callback
+// of independent solves (one solve at a time per context)
+typedef struct SudokuSolver SudokuSolver;
+
+// Called synchronously on the solving thread for every solver event
+typedef void (*SolverCallback)(void* userData, EventLevel level, EventKind kind,
+                               int generation, int fitness, const char* message);
+
+// State of a random number generator (xorshift64*)
+typedef struct {
+    unsigned long long state;
+} RandomState;
+
+// Progress of the running solve, shared with the interactive front end
+typedef struct {
+    atomic_int generation;
+    atomic_int bestFitness;
+    atomic_int improvements;
+    atomic_int cancelRequested;  // Set by the front end, checked by the solve budget
+} SolverProgress;
+
+// Genetic algorithm parameters set at runtime (defaults are the #defines above)
+typedef struct {
+    int populationSize;
+    int maxGenerations;
+    int stagnationLimit;
+    double crossoverRate;     // Rate at healthy diversity when adaptiveRates is set
+    double mutationRate;      // Rate at healthy diversity when adaptiveRates is set
+    int tournamentSize;
+    int eliteCount;
+    int adaptiveRates;
+    int hybridFinisher;
+    SelectionType selection;
+    CrossoverType crossover;
+    MutationType mutation;
+    EvolutionMode evolutionMode;
+    ReplacementPolicy replacement;  // Steady-state only
+    int steadyStateChildren;        // Steady-state only - children per step
+    double timeLimit;         // Wall-clock seconds per solve (0 = none)
+    long maxEvaluations;      // Fitness evaluations per solve (0 = none)
+    int targetFitness;
+    int verbose;              // Print progress from evolve()
+} GAParameters;
+
+// Everything a running solve uses besides its population. solve() builds it
+// from the solver and passes it down the engines explicitly, so solves on
+// different threads share nothing.
+typedef struct {
+    const GAParameters* parameters;
+    RandomState* random;
+    EventLog* log;              // May be NULL
+    SolverCallback callback;    // May be NULL
+    void* callbackData;
+    SolverProgress* progress;   // May be NULL
+    long evaluations;           // Fitness evaluations of the solve so far
+} SolveState;
+
+// Set of cells, one bit per cell (row * BOARD_SIZE + col), 32 cells per word
+#define MASK_WORDS 3
+typedef struct {
+    unsigned int words[MASK_WORDS];
+} CellMask;
+
+// Free cells of a puzzle, built once so mutations pick targets in constant time.
+// Cells are stored as row * BOARD_SIZE + col.
+typedef struct {
+    unsigned char freeCells[BOARD_SIZE * BOARD_SIZE];
+    int freeCount;
+    unsigned char rowCells[BOARD_SIZE][BOARD_SIZE];   // Free cells of each row
+    unsigned char rowCount[BOARD_SIZE];
+    unsigned char colCells[BOARD_SIZE][BOARD_SIZE];   // Free cells of each column
+    unsigned char colCount[BOARD_SIZE];
+    unsigned char blockCells[BOARD_SIZE][BOARD_SIZE]; // Free cells of each 3x3 block
+    unsigned char blockCount[BOARD_SIZE];
+    unsigned char swapRows[BOARD_SIZE];               // Units with at least two free cells
+    int swapRowCount;
+    unsigned char swapCols[BOARD_SIZE];
+    int swapColCount;
+    unsigned char swapBlocks[BOARD_SIZE];
+    int swapBlockCount;
+    unsigned char blockPairCells[BLOCK_SIZE * 3][BOARD_SIZE][2]; // Same-band block pairs: the cell pairs
+    unsigned char blockPairSize[BLOCK_SIZE * 3];                 // free in both blocks (at least one)
+    int blockPairCount;
+    CellMask freeMask;                                // Free cells as masks, for crossover
+    CellMask rowMasks[BOARD_SIZE];
+    CellMask blockMasks[BOARD_SIZE];
+    CellMask bandMasks[BLOCK_SIZE];                   // Three rows of blocks each
+} PuzzleIndex;
+
+// Units of a board: rows, then columns, then 3x3 blocks
+#define UNIT_COUNT (3 * BOARD_SIZE)
+#define ROW_UNIT(row) (row)
+#define COLUMN_UNIT(col) (BOARD_SIZE + (col))
+#define BLOCK_UNIT(row, col) (2 * BOARD_SIZE + ((row) / BLOCK_SIZE) * BLOCK_SIZE + (col) / BLOCK_SIZE)
+
 // Structure representing a Sudoku board
 typedef struct {
     int board[BOARD_SIZE][BOARD_SIZE];   // 9x9 Sudoku grid
     int initial[BOARD_SIZE][BOARD_SIZE]; // Initial board state (fixed numbers)
     int fitness;                         // Fitness value (higher is better)
+    unsigned char unitDigits[UNIT_COUNT][10]; // How often each digit occurs per unit - set by
+                                              // calculateFitness(), kept current by setCell()
+    const PuzzleIndex* index;            // Free-cell tables of the puzzle (may be NULL)
 } SudokuBoard;
 
-// Structure representing a population of Sudoku boards
+// Structure with incrementally collected population diversity statistics
+typedef struct {
+    int counts[BOARD_SIZE][BOARD_SIZE][10]; // How many individuals hold each value per cell
+    int fixed[BOARD_SIZE][BOARD_SIZE];      // Cells excluded from the metrics
+    int freeCells;                          // Number of non-fixed cells
+    int size;                               // Number of individuals counted
+    double entropy;                         // Mean per-cell value entropy (0..1)
+    double hamming;                         // Mean pairwise Hamming distance per free cell (0..1)
+} PopulationDiversity;
+
+// Population positions kept ordered by fitness (best first) while the
+// steady-state engine replaces boards one at a time
+typedef struct {
+    int order[MAX_POPULATION_SIZE];   // Board positions, best first
+    int rankOf[MAX_POPULATION_SIZE];  // Inverse of order
+} FitnessOrder;
+
+// Structure representing a population of Sudoku boards. Everything an
+// engine needs besides the boards is allocated with them, so a solve
+// allocates nothing.
 typedef struct {
     SudokuBoard* boards;  // Array of Sudoku boards
-    int size;            // Population size
+    SudokuBoard* spare;   // Buffer the next generation is built in
+    int size;            // Population size (2..MAX_POPULATION_SIZE)
+    PuzzleIndex* index;  // Free-cell tables shared by all boards
+    PopulationDiversity* diversity;      // Statistics of the current generation
+    PopulationDiversity* nextDiversity;  // and of the one being built
+    FitnessOrder* ranking;               // Steady-state fitness order
 } Population;
 
+// Structure with the statistics of a multi-armed bandit choosing operators
+typedef struct {
+    int armCount;                    // Number of operators to choose from
+    double pulls[MAX_BANDIT_ARMS];   // Discounted number of uses
+    double gain[MAX_BANDIT_ARMS];    // Discounted fitness improvement produced
+    double seconds[MAX_BANDIT_ARMS]; // Discounted CPU time spent
+    double cost[MAX_BANDIT_ARMS];    // Moving mean CPU time of the timed pulls
+    long uses[MAX_BANDIT_ARMS];      // Undiscounted number of uses
+    double totalPulls;               // Discounted sum of pulls
+} OperatorBandit;
+
+// Limits of one solve, checked inside the evolution loops
+typedef struct {
+    double start;          // Wall-clock time the solve started
+    double deadline;       // 0 = no time limit
+    long firstEvaluation;  // Evaluations of the solve state when the budget started
+    long maxEvaluations;   // 0 = no evaluation limit
+    int targetFitness;
+} SolveBudget;
+
+// Outcome of a solve - the best board found so far and why the solve stopped
+typedef struct {
+    SudokuBoard best;
+    StopReason reason;
+    int generations;
+    long evaluations;
+    double seconds;        // Wall-clock time
+} SolveResult;
+
+// Rates and operator bandits used while breeding children
+typedef struct {
+    double crossoverRate;
+    double mutationRate;
+    OperatorBandit crossoverBandit;
+    OperatorBandit mutationBandit;
+} BreedingState;
+
+// Puzzle made by the generator, rated by the genetic algorithm's work
+typedef struct {
+    int puzzle[BOARD_SIZE][BOARD_SIZE];    // Clues, 0 = empty cell
+    int solution[BOARD_SIZE][BOARD_SIZE];  // The unique solution
+    int clues;
+    long rating;           // Fitness evaluations the solver used (0 = not rated)
+    int ratingFitness;     // Best fitness the solver reached
+    StopReason ratingStop; // STOP_TARGET_REACHED (or STOP_SOLVED) if it reached RATING_FITNESS
+} GeneratedPuzzle;
+
+// Totals of a generator run over all its threads
+typedef struct {
+    long puzzles;
+    long clues;
+    long evaluations;        // Rating evaluations (0 without rating)
+    long reachedTarget;      // Rated puzzles that reached RATING_FITNESS within the budget
+    int threads;             // Threads that ran
+    double seconds;          // Wall-clock time of the run
+    double generateSeconds;  // CPU time spent making puzzles
+    double rateSeconds;      // CPU time spent rating them
+} GeneratorStats;
+
+// Puzzle in compact form: one byte per cell, row by row, 0 = empty
+typedef struct {
+    unsigned char cells[BOARD_SIZE * BOARD_SIZE];
+} CompactPuzzle;
+
+// Read-only view of a puzzle file, memory-mapped where supported
+typedef struct {
+    const char* data;
+    size_t length;
+    size_t position;     // Start of the next line
+    const char* line;    // Last line read (not terminated)
+    size_t lineLength;
+    long lineNumber;
+    long invalidLines;   // Malformed or contradictory lines skipped
+    int validateClues;   // Reject puzzles whose clues repeat a digit in a unit
+    int mapped;          // 1 = mmap, 0 = heap copy, -1 = caller's buffer
+} PuzzleCorpus;
+
+// Totals of a verification run over two files read line by line in lockstep
+typedef struct {
+    long lines;               // Line pairs read
+    long checked;             // Pairs with a puzzle or a solution (not both blank)
+    long failed;
+    long badRows;             // Failed solutions by kind of fault
+    long badColumns;
+    long badBlocks;
+    long changedClues;
+    long malformedPuzzles;    // Puzzle lines missing or malformed
+    long malformedSolutions;
+    long surplusPuzzles;      // Non-blank lines after the end of the other file
+    long surplusSolutions;
+    double seconds;           // Wall-clock time
+} VerifyStats;
+
+// Buffered writer collecting results into large batches
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t used;
+    int ownsFile;
+    int failed;
+} ResultWriter;
+
 // Initialization functions
-void initializeBoard(SudokuBoard* board);
-Population* createPopulation(void);
+void initializeBoard(SudokuBoard* board, RandomState* random);
+void initializeBoardFromPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                               RandomState* random);
+Population* createPopulation(int size, RandomState* random);
+Population* createPopulationFromPuzzle(const int puzzle[BOARD_SIZE][BOARD_SIZE], int size,
+                                       RandomState* random);
+Population* allocatePopulation(int size);
+void resetPopulation(Population* population, const int puzzle[BOARD_SIZE][BOARD_SIZE],
+                     RandomState* random);
 void destroyPopulation(Population* population);
 void setInitialPuzzle(SudokuBoard* board, const int puzzle[BOARD_SIZE][BOARD_SIZE]);
 
@@ -60,37 +415,171 @@ int isValidSolution(SudokuBoard* board);
 int countConflicts(SudokuBoard* board);
 
 // Genetic operators - Selection
-SudokuBoard selectParent(Population* population, SelectionType type);
-SudokuBoard tournamentSelection(Population* population, int tournamentSize);
-SudokuBoard rouletteSelection(Population* population);
-SudokuBoard rankingSelection(Population* population);
+SudokuBoard selectParent(Population* population, SelectionType type, int tournamentSize,
+                         RandomState* random);
+SudokuBoard tournamentSelection(Population* population, int tournamentSize, RandomState* random);
+SudokuBoard rouletteSelection(Population* population, RandomState* random);
+SudokuBoard rankingSelection(Population* population, RandomState* random);
+int selectParentIndex(Population* population, SelectionType type, int tournamentSize,
+                      RandomState* random);
+int tournamentSelectionIndex(Population* population, int tournamentSize, RandomState* random);
+int rouletteSelectionIndex(Population* population, RandomState* random);
+int rankingSelectionIndex(Population* population, RandomState* random);
 
 // Genetic operators - Crossover
 void crossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-              SudokuBoard* child, CrossoverType type);
+              SudokuBoard* child, CrossoverType type, RandomState* random);
 void singlePointCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                         SudokuBoard* child);
+                         SudokuBoard* child, RandomState* random);
 void multiPointCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                        SudokuBoard* child);
+                        SudokuBoard* child, RandomState* random);
 void uniformCrossover(SudokuBoard* parent1, SudokuBoard* parent2, 
-                     SudokuBoard* child);
+                     SudokuBoard* child, RandomState* random);
+void rowCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                  RandomState* random);
+void bandCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   RandomState* random);
+void maskCrossover(SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                   const CellMask* mask);
+const char* crossoverName(CrossoverType type);
 
 // Genetic operators - Mutation
-void mutate(SudokuBoard* board, MutationType type);
-void rowSwapMutation(SudokuBoard* board);
-void blockSwapMutation(SudokuBoard* board);
-void randomChangeMutation(SudokuBoard* board);
+void mutate(SudokuBoard* board, MutationType type, RandomState* random);
+void rowSwapMutation(SudokuBoard* board, RandomState* random);
+void blockSwapMutation(SudokuBoard* board, RandomState* random);
+void randomChangeMutation(SudokuBoard* board, RandomState* random);
+void conflictChangeMutation(SudokuBoard* board, RandomState* random);
+void conflictSwapMutation(SudokuBoard* board, RandomState* random);
+const char* mutationName(MutationType type);
 
 // Helper functions
 void printBoard(SudokuBoard* board);
 void copyBoard(SudokuBoard* source, SudokuBoard* destination);
+void setCell(SudokuBoard* board, int cell, int num);
 int isValidNumber(SudokuBoard* board, int row, int col, int num);
 int isFixed(SudokuBoard* board, int row, int col);
 
+// Population diversity
+void resetDiversity(PopulationDiversity* diversity, SudokuBoard* reference);
+void addToDiversity(PopulationDiversity* diversity, SudokuBoard* board);
+void removeFromDiversity(PopulationDiversity* diversity, SudokuBoard* board);
+void computeDiversity(PopulationDiversity* diversity);
+void adaptRates(PopulationDiversity* diversity, const GAParameters* parameters,
+                double* crossoverRate, double* mutationRate);
+
+// Adaptive operator selection
+void initBandit(OperatorBandit* bandit, int armCount);
+int selectArm(OperatorBandit* bandit, RandomState* random);
+int timeArm(OperatorBandit* bandit, int arm);
+void recordArmTime(OperatorBandit* bandit, int arm, double seconds);
+void rewardArm(OperatorBandit* bandit, int arm, double gain);
+
+// Time measurement
+double cpuTimeSeconds(void);
+double wallTimeSeconds(void);
+
+// Solve budgets
+void startBudget(SolveBudget* budget, const SolveState* state);
+StopReason checkBudget(SolveBudget* budget, const SolveState* state, int bestFitness);
+long budgetEvaluations(SolveBudget* budget, const SolveState* state);
+int evaluationsLeft(SolveBudget* budget, const SolveState* state);
+const char* stopReasonName(StopReason reason);
+
+// Runtime parameters
+void setDefaultParameters(GAParameters* parameters);
+void validateParameters(GAParameters* parameters);
+int loadParameters(const char* path, GAParameters* parameters);
+int saveParameters(const char* path, const GAParameters* parameters);
+
+// Exact solver
+int solveExact(const int puzzle[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE]);
+long countSolutions(const int puzzle[BOARD_SIZE][BOARD_SIZE], long limit);
+int solveBoardExact(SudokuBoard* board);
+int finishBoard(SudokuBoard* board);
+
+// Puzzle corpus reading and result writing
+int openCorpus(PuzzleCorpus* corpus, const char* path);
+void openCorpusBuffer(PuzzleCorpus* corpus, const char* data, size_t length);
+int nextPuzzle(PuzzleCorpus* corpus, CompactPuzzle* puzzle);
+int nextLine(PuzzleCorpus* corpus, CompactPuzzle* puzzle, LineKind* kind);
+int nextRawLine(PuzzleCorpus* corpus);
+LineKind parseLine(const char* line, size_t length, int validateClues, CompactPuzzle* puzzle);
+void closeCorpus(PuzzleCorpus* corpus);
+void expandPuzzle(const CompactPuzzle* puzzle, int grid[BOARD_SIZE][BOARD_SIZE]);
+void compactGrid(const int grid[BOARD_SIZE][BOARD_SIZE], CompactPuzzle* puzzle);
+int openResultWriter(ResultWriter* writer, const char* path);
+void writeGrid(ResultWriter* writer, const int grid[BOARD_SIZE][BOARD_SIZE]);
+void writeText(ResultWriter* writer, const char* text, size_t length);
+int closeResultWriter(ResultWriter* writer);
+
+// Asynchronous event log
+EventLog* createEventLog(FILE* output, EventFormat format, EventLevel minLevel);
+void destroyEventLog(EventLog* log);
+void postEvent(EventLog* log, EventLevel level, EventKind kind,
+               int generation, int fitness, const char* message);
+long droppedEvents(EventLog* log);
+void solverEvent(const SolveState* state, EventLevel level, EventKind kind,
+                 int generation, int fitness, const char* message);
+
+// Random numbers
+void seedRandom(RandomState* random, unsigned long long seed);
+int randomInt(RandomState* random, int bound);
+unsigned int randomWord(RandomState* random);
+double randomUnit(RandomState* random);
+
+// Bulk solution verification
+unsigned int verifySolution(const CompactPuzzle* puzzle, const CompactPuzzle* solution);
+long verifySolutions(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                     unsigned int* diagnostics, unsigned char* passBitmap);
+long verifyInParallel(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                      unsigned int* diagnostics, unsigned char* passBitmap, int threads);
+int verifyCorpora(PuzzleCorpus* puzzles, PuzzleCorpus* solutions, int threads,
+                  ResultWriter* report, ResultWriter* bitmap, VerifyStats* stats);
+int formatVerifyFailure(long line, unsigned int diagnostic, char* text, size_t size);
+
+// Puzzle generator
+void generateSolvedGrid(int grid[BOARD_SIZE][BOARD_SIZE], RandomState* random);
+int removeClues(int puzzle[BOARD_SIZE][BOARD_SIZE], int minClues, RandomState* random);
+void generatePuzzle(GeneratedPuzzle* generated, int minClues, RandomState* random);
+void ratePuzzle(SudokuSolver* solver, GeneratedPuzzle* generated);
+int formatGenerated(const GeneratedPuzzle* generated, int rated, char* line, size_t size);
+void generatePuzzles(const GAParameters* parameters, long count, int minClues, int threads,
+                     unsigned long long seed, ResultWriter* writer, GeneratorStats* stats);
+
+// Solver contexts - reentrant library interface
+SudokuSolver* createSolver(const GAParameters* parameters);
+void destroySolver(SudokuSolver* solver);
+int setSolverParameters(SudokuSolver* solver, const GAParameters* parameters);
+const GAParameters* getSolverParameters(SudokuSolver* solver);
+void setSolverSeed(SudokuSolver* solver, unsigned long long seed);
+void setSolverLog(SudokuSolver* solver, EventLog* log);
+void setSolverCallback(SudokuSolver* solver, SolverCallback callback, void* userData);
+const SolverProgress* getSolverProgress(SudokuSolver* solver);
+void cancelSolve(SudokuSolver* solver);
+SolveResult solve(SudokuSolver* solver, const int puzzle[BOARD_SIZE][BOARD_SIZE]);
+
+// Free-cell index tables
+void buildPuzzleIndex(PuzzleIndex* index, const int initial[BOARD_SIZE][BOARD_SIZE]);
+const PuzzleIndex* boardPuzzleIndex(SudokuBoard* board, PuzzleIndex* scratch);
+
 // Evolution function
-SudokuBoard evolve(Population* population, 
-                  SelectionType selType,
-                  CrossoverType crossType,
-                  MutationType mutType);
+SolveResult evolve(SolveState* state, Population* population,
+                   SelectionType selType,
+                   CrossoverType crossType,
+                   MutationType mutType);
+SolveResult evolveSteadyState(SolveState* state, Population* population,
+                              SelectionType selType,
+                              CrossoverType crossType,
+                              MutationType mutType);
+void initBreeding(SolveState* state, BreedingState* breeding);
+void breedChild(SolveState* state, SudokuBoard* parent1, SudokuBoard* parent2, SudokuBoard* child,
+                CrossoverType crossType, MutationType mutType, BreedingState* breeding,
+                SolveBudget* budget);
+void reportEvolutionStart(SolveState* state, int fitness);
+void reportImprovement(SolveState* state, int generation, int improvements, int fitness,
+                       PopulationDiversity* diversity, BreedingState* breeding);
+SolveResult finishEvolution(SolveState* state, SudokuBoard* best, int generation, StopReason reason,
+                            SolveBudget* budget, CrossoverType crossType, MutationType mutType,
+                            BreedingState* breeding);
 
 #endif //ALGORYTMGENETYCZNYSUDOKU_SUDOKU_H
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+// Minimal assertions for the ctest executables: a failed check is printed
+// and the test exits with status 1 once all checks have run
+static int checkFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if(!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            checkFailures++; \
+        } \
+    } while(0)
+
+#define CHECK_RESULT() (checkFailures == 0 ? 0 : 1)
+
+#endif
@@ -0,0 +1,94 @@
+#include "sudoku.h"
+#include "parameters.h"
+#include "board_operations.h"
+#include "budget.h"
+#include "solver.h"
+#include "check.h"
+
+// Stop conditions checked in the middle of a generation, in priority order
+static void testCheckBudget(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.timeLimit = 0.0;
+    parameters.maxEvaluations = 100;
+    parameters.targetFitness = 240;
+
+    SolverProgress progress = {0};
+    SolveState state = {0};
+    state.parameters = &parameters;
+    state.progress = &progress;
+    state.evaluations = 1000;
+
+    SolveBudget budget;
+    startBudget(&budget, &state);
+    CHECK(checkBudget(&budget, &state, 200) == STOP_NONE);
+    CHECK(checkBudget(&budget, &state, 243) == STOP_SOLVED);
+    CHECK(checkBudget(&budget, &state, 240) == STOP_TARGET_REACHED);
+
+    // The limit counts evaluations since the budget started
+    state.evaluations += 99;
+    CHECK(budgetEvaluations(&budget, &state) == 99);
+    CHECK(checkBudget(&budget, &state, 200) == STOP_NONE);
+    state.evaluations++;
+    CHECK(checkBudget(&budget, &state, 200) == STOP_EVALUATION_LIMIT);
+
+    // Cancelling wins over the evaluation limit, a solution over both
+    atomic_store(&progress.cancelRequested, 1);
+    CHECK(checkBudget(&budget, &state, 200) == STOP_CANCELLED);
+    CHECK(checkBudget(&budget, &state, 243) == STOP_SOLVED);
+
+    // A deadline already passed
+    parameters.maxEvaluations = 0;
+    parameters.timeLimit = 1e-9;
+    atomic_store(&progress.cancelRequested, 0);
+    startBudget(&budget, &state);
+    while(checkBudget(&budget, &state, 200) == STOP_NONE) {}
+    CHECK(checkBudget(&budget, &state, 200) == STOP_TIME_LIMIT);
+}
+
+// A solve never goes past its evaluation limit, whatever the seed or engine
+static void testSolveLimit(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.hybridFinisher = 0;
+    parameters.verbose = 0;
+    parameters.timeLimit = 0.0;
+    parameters.maxEvaluations = 500;
+    parameters.steadyStateChildren = 16;
+
+    SudokuSolver* solver = createSolver(&parameters);
+    for(int mode = GENERATIONAL; mode <= STEADY_STATE; mode++) {
+        parameters.evolutionMode = (EvolutionMode)mode;
+        setSolverParameters(solver, &parameters);
+        for(unsigned long long seed = 1; seed <= 100; seed++) {
+            setSolverSeed(solver, seed);
+            SolveResult result = solve(solver, INITIAL_PUZZLE);
+            CHECK(result.evaluations <= 500);
+            if(result.reason == STOP_EVALUATION_LIMIT) CHECK(result.evaluations == 500);
+            else CHECK(result.reason == STOP_SOLVED);
+        }
+    }
+    destroySolver(solver);
+}
+
+// The hybrid finisher completes a board stopped by the budget
+static void testFinisherAfterBudget(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.verbose = 0;
+    parameters.maxEvaluations = 100;
+
+    SudokuSolver* solver = createSolver(&parameters);
+    setSolverSeed(solver, 1);
+    SolveResult result = solve(solver, INITIAL_PUZZLE);
+    CHECK(result.reason == STOP_EVALUATION_LIMIT);
+    CHECK(result.best.fitness == 243);
+    destroySolver(solver);
+}
+
+int main(void) {
+    testCheckBudget();
+    testSolveLimit();
+    testFinisherAfterBudget();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,116 @@
+#include <string.h>
+#include "sudoku.h"
+#include "board_operations.h"
+#include "crossover.h"
+#include "puzzle_index.h"
+#include "rng.h"
+#include "check.h"
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+
+static int cell(const SudokuBoard* board, int i) {
+    return board->board[i / BOARD_SIZE][i % BOARD_SIZE];
+}
+
+static int maskBit(const CellMask* mask, int i) {
+    return (mask->words[i / 32] >> (i % 32)) & 1u;
+}
+
+// Child must take the masked free cells from parent2, every other cell from
+// parent1, and carry a fitness and digit counts matching its cells
+static int isMaskChild(const SudokuBoard* parent1, const SudokuBoard* parent2,
+                       SudokuBoard* child, const CellMask* mask) {
+    for(int i = 0; i < CELL_COUNT; i++) {
+        int free = parent1->initial[i / BOARD_SIZE][i % BOARD_SIZE] == 0;
+        int expected = free && maskBit(mask, i) ? cell(parent2, i) : cell(parent1, i);
+        if(cell(child, i) != expected) return 0;
+    }
+
+    SudokuBoard check;
+    copyBoard(child, &check);
+    int fitness = calculateFitness(&check);
+    return child->fitness == fitness &&
+           memcmp(child->unitDigits, check.unitDigits, sizeof(check.unitDigits)) == 0;
+}
+
+// Two random parents of the built-in puzzle with its last cell made free
+static void makeParents(SudokuBoard* parent1, SudokuBoard* parent2, PuzzleIndex* index,
+                        RandomState* random) {
+    int puzzle[BOARD_SIZE][BOARD_SIZE];
+    memcpy(puzzle, INITIAL_PUZZLE, sizeof(puzzle));
+    puzzle[BOARD_SIZE - 1][BOARD_SIZE - 1] = 0;
+    buildPuzzleIndex(index, puzzle);
+
+    initializeBoardFromPuzzle(parent1, puzzle, random);
+    do {
+        initializeBoardFromPuzzle(parent2, puzzle, random);
+    } while(cell(parent1, CELL_COUNT - 1) == cell(parent2, CELL_COUNT - 1));
+    parent1->index = index;
+    parent2->index = index;
+}
+
+// The last cell is blended outside the vector loops - it must follow its bit
+static void testLastCell(void) {
+    RandomState random;
+    seedRandom(&random, 1);
+    PuzzleIndex index;
+    SudokuBoard parent1, parent2, child;
+    makeParents(&parent1, &parent2, &index, &random);
+
+    CellMask mask = {{0, 0, 1u << (CELL_COUNT - 1 - 64)}};
+    maskCrossover(&parent1, &parent2, &child, &mask);
+    CHECK(cell(&child, CELL_COUNT - 1) == cell(&parent2, CELL_COUNT - 1));
+    CHECK(isMaskChild(&parent1, &parent2, &child, &mask));
+
+    CellMask others = {{0xFFFFFFFFu, 0xFFFFFFFFu, ~(1u << (CELL_COUNT - 1 - 64))}};
+    maskCrossover(&parent1, &parent2, &child, &others);
+    CHECK(cell(&child, CELL_COUNT - 1) == cell(&parent1, CELL_COUNT - 1));
+    CHECK(isMaskChild(&parent1, &parent2, &child, &others));
+}
+
+static void testRandomMasks(void) {
+    RandomState random;
+    seedRandom(&random, 2);
+    PuzzleIndex index;
+    SudokuBoard parent1, parent2, child;
+
+    int failures = 0;
+    for(int round = 0; round < 1000; round++) {
+        makeParents(&parent1, &parent2, &index, &random);
+        CellMask mask;
+        for(int w = 0; w < MASK_WORDS; w++) mask.words[w] = randomWord(&random);
+        maskCrossover(&parent1, &parent2, &child, &mask);
+        failures += !isMaskChild(&parent1, &parent2, &child, &mask);
+    }
+    CHECK(failures == 0);
+}
+
+// Every crossover type keeps the clues and leaves a consistent fitness
+static void testCrossoverTypes(void) {
+    RandomState random;
+    seedRandom(&random, 3);
+    PuzzleIndex index;
+    SudokuBoard parent1, parent2, child;
+    makeParents(&parent1, &parent2, &index, &random);
+
+    for(int type = SINGLE_POINT; type < ADAPTIVE_CROSSOVER; type++) {
+        for(int round = 0; round < 100; round++) {
+            crossover(&parent1, &parent2, &child, (CrossoverType)type, &random);
+            int kept = 1;
+            for(int i = 0; i < CELL_COUNT; i++) {
+                int free = parent1.initial[i / BOARD_SIZE][i % BOARD_SIZE] == 0;
+                if(cell(&child, i) != cell(&parent1, i) && (!free || cell(&child, i) != cell(&parent2, i))) kept = 0;
+            }
+            SudokuBoard check;
+            copyBoard(&child, &check);
+            CHECK(kept && child.fitness == calculateFitness(&check));
+        }
+    }
+}
+
+int main(void) {
+    testLastCell();
+    testRandomMasks();
+    testCrossoverTypes();
+    return CHECK_RESULT();
+}
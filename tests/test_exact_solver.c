@@ -0,0 +1,82 @@
+#include <string.h>
+#include "sudoku.h"
+#include "board_operations.h"
+#include "exact_solver.h"
+#include "check.h"
+
+// Every row, column and block of a complete grid holds 1..9
+static int isCompleteGrid(const int grid[BOARD_SIZE][BOARD_SIZE]) {
+    for(int unit = 0; unit < BOARD_SIZE; unit++) {
+        int rowSeen = 0, colSeen = 0, blockSeen = 0;
+        for(int i = 0; i < BOARD_SIZE; i++) {
+            int blockRow = (unit / BLOCK_SIZE) * BLOCK_SIZE + i / BLOCK_SIZE;
+            int blockCol = (unit % BLOCK_SIZE) * BLOCK_SIZE + i % BLOCK_SIZE;
+            rowSeen |= 1 << grid[unit][i];
+            colSeen |= 1 << grid[i][unit];
+            blockSeen |= 1 << grid[blockRow][blockCol];
+        }
+        if(rowSeen != 0x3FE || colSeen != 0x3FE || blockSeen != 0x3FE) return 0;
+    }
+    return 1;
+}
+
+static int keepsClues(const int puzzle[BOARD_SIZE][BOARD_SIZE], const int grid[BOARD_SIZE][BOARD_SIZE]) {
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            if(puzzle[row][col] != 0 && puzzle[row][col] != grid[row][col]) return 0;
+        }
+    }
+    return 1;
+}
+
+static void testSolveExact(void) {
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    CHECK(solveExact(INITIAL_PUZZLE, solution) == 1);
+    CHECK(isCompleteGrid(solution));
+    CHECK(keepsClues(INITIAL_PUZZLE, solution));
+}
+
+static void testCountSolutions(void) {
+    int puzzle[BOARD_SIZE][BOARD_SIZE];
+    memcpy(puzzle, INITIAL_PUZZLE, sizeof(puzzle));
+    CHECK(countSolutions(puzzle, 2) == 1);
+
+    // An empty grid has many solutions; the count stops at the limit
+    int empty[BOARD_SIZE][BOARD_SIZE] = {{0}};
+    CHECK(countSolutions(empty, 2) == 2);
+    CHECK(countSolutions(empty, 5) == 5);
+
+    // Clues that repeat a digit in a row have no solution
+    puzzle[0][2] = 5;
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    CHECK(countSolutions(puzzle, 2) == 0);
+    CHECK(solveExact(puzzle, solution) == 0);
+}
+
+static void testFinishBoard(void) {
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    solveExact(INITIAL_PUZZLE, solution);
+
+    // A solved board with two free cells swapped - the finisher repairs it
+    SudokuBoard board;
+    memset(&board, 0, sizeof(board));
+    setInitialPuzzle(&board, INITIAL_PUZZLE);
+    memcpy(board.board, solution, sizeof(board.board));
+    int swap = board.board[0][2];
+    board.board[0][2] = board.board[0][3];
+    board.board[0][3] = swap;
+    calculateFitness(&board);
+    CHECK(board.fitness < 243);
+
+    CHECK(finishBoard(&board) == 1);
+    CHECK(board.fitness == 243);
+    CHECK(isCompleteGrid((const int (*)[BOARD_SIZE])board.board));
+    CHECK(keepsClues(INITIAL_PUZZLE, (const int (*)[BOARD_SIZE])board.board));
+}
+
+int main(void) {
+    testSolveExact();
+    testCountSolutions();
+    testFinishBoard();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,121 @@
+#include <string.h>
+#include "sudoku.h"
+#include "board_operations.h"
+#include "mutation.h"
+#include "generator.h"
+#include "puzzle_index.h"
+#include "rng.h"
+#include "check.h"
+
+static const MutationType MUTATIONS[] = {
+    ROW_SWAP, BLOCK_SWAP, RANDOM_CHANGE, CONFLICT_CHANGE, CONFLICT_SWAP
+};
+#define MUTATION_COUNT (int)(sizeof(MUTATIONS) / sizeof(MUTATIONS[0]))
+
+// Fitness and digit counts must be what a full evaluation of the cells gives
+static int countsCurrent(const SudokuBoard* board) {
+    SudokuBoard check;
+    memcpy(&check, board, sizeof(SudokuBoard));
+    int fitness = calculateFitness(&check);
+    return board->fitness == fitness &&
+           memcmp(board->unitDigits, check.unitDigits, sizeof(check.unitDigits)) == 0;
+}
+
+static int cluesKept(const SudokuBoard* board) {
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            int clue = board->initial[row][col];
+            if(clue && board->board[row][col] != clue) return 0;
+        }
+    }
+    return 1;
+}
+
+// Every mutation - full evaluation or setCell() updates - leaves the board's
+// fitness and digit counts current and its clues in place
+static void testCountsFollowMutations(void) {
+    PuzzleIndex index;
+    buildPuzzleIndex(&index, INITIAL_PUZZLE);
+
+    for(int m = 0; m < MUTATION_COUNT; m++) {
+        for(unsigned long long seed = 1; seed <= 50; seed++) {
+            RandomState random;
+            seedRandom(&random, seed);
+            SudokuBoard board;
+            initializeBoardFromPuzzle(&board, INITIAL_PUZZLE, &random);
+            board.index = seed % 2 ? &index : NULL;  // Both the shared and the scratch index
+
+            for(int step = 0; step < 20; step++) {
+                mutate(&board, MUTATIONS[m], &random);
+                CHECK(countsCurrent(&board));
+                CHECK(cluesKept(&board));
+            }
+        }
+    }
+}
+
+// Puzzle from a solved grid with the given cells left free
+static void makePuzzle(int puzzle[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE],
+                       const int* freeCells, int freeCount) {
+    memcpy(puzzle, solution, BOARD_SIZE * BOARD_SIZE * sizeof(int));
+    for(int i = 0; i < freeCount; i++) {
+        puzzle[freeCells[i] / BOARD_SIZE][freeCells[i] % BOARD_SIZE] = 0;
+    }
+}
+
+// Rows, columns and blocks with fewer than two free cells leave the swap
+// mutations nothing to exchange - they must return (not spin looking for a
+// second cell) and leave the board as it was
+static void testNoSwappableCells(void) {
+    RandomState random;
+    seedRandom(&random, 7);
+    int solution[BOARD_SIZE][BOARD_SIZE];
+    generateSolvedGrid(solution, &random);
+
+    // One free cell per row, column and block, at a different position of
+    // each block so no block pair shares a free position either
+    static const int spread[BOARD_SIZE] = {0, 12, 24, 28, 40, 52, 56, 68, 80};
+    int puzzles[2][BOARD_SIZE][BOARD_SIZE];
+    makePuzzle(puzzles[0], solution, spread, BOARD_SIZE);
+    makePuzzle(puzzles[1], solution, spread, 0);  // No free cell at all
+
+    for(int p = 0; p < 2; p++) {
+        PuzzleIndex index;
+        buildPuzzleIndex(&index, puzzles[p]);
+        CHECK(index.swapRowCount == 0 && index.swapBlockCount == 0 && index.blockPairCount == 0);
+
+        for(int wrong = 0; wrong < 2; wrong++) {
+            SudokuBoard board;
+            initializeBoardFromPuzzle(&board, puzzles[p], &random);
+            board.index = &index;
+            // The solution's digits, or wrong ones so every free cell conflicts
+            for(int i = 0; i < index.freeCount; i++) {
+                int cell = index.freeCells[i];
+                int num = solution[cell / BOARD_SIZE][cell % BOARD_SIZE];
+                setCell(&board, cell, wrong ? num % 9 + 1 : num);
+            }
+
+            for(int m = 0; m < MUTATION_COUNT; m++) {
+                SudokuBoard before;
+                memcpy(&before, &board, sizeof(SudokuBoard));
+                for(int step = 0; step < 20; step++) mutate(&board, MUTATIONS[m], &random);
+                CHECK(countsCurrent(&board));
+                CHECK(cluesKept(&board));
+
+                // Single-cell changes may still act on conflicts (or at random)
+                if(MUTATIONS[m] == RANDOM_CHANGE || (MUTATIONS[m] == CONFLICT_CHANGE && wrong)) {
+                    if(index.freeCount == 0) CHECK(memcmp(&board, &before, sizeof(SudokuBoard)) == 0);
+                } else {
+                    CHECK(memcmp(&board, &before, sizeof(SudokuBoard)) == 0);
+                }
+                memcpy(&board, &before, sizeof(SudokuBoard));
+            }
+        }
+    }
+}
+
+int main(void) {
+    testCountsFollowMutations();
+    testNoSwappableCells();
+    return CHECK_RESULT();
+}
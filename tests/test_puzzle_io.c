@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+#include "sudoku.h"
+#include "board_operations.h"
+#include "puzzle_io.h"
+#include "check.h"
+
+#define PUZZLE "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79"
+#define ZEROS  "530070000600195000098000060800060003400803001700020006060000280000419005000080079"
+#define CLASH  "55..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79"
+
+static const char CORPUS[] =
+    PUZZLE "\n"                 // 1: puzzle
+    "# comment\n"               // 2: empty
+    "\n"                        // 3: empty
+    ZEROS " 23 rated\r\n"       // 4: puzzle with trailing text and CRLF
+    "53..7....6..195\n"         // 5: too short
+    PUZZLE "1\n"                // 6: 82 cells
+    "53..7....6..x95....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79\n"  // 7: bad cell
+    CLASH "\n"                  // 8: clues repeat a digit
+    PUZZLE;                     // 9: puzzle without a final newline
+
+static int matchesInitial(const CompactPuzzle* puzzle) {
+    int grid[BOARD_SIZE][BOARD_SIZE];
+    expandPuzzle(puzzle, grid);
+    return memcmp(grid, INITIAL_PUZZLE, sizeof(grid)) == 0;
+}
+
+static void testNextPuzzle(void) {
+    PuzzleCorpus corpus;
+    CompactPuzzle puzzle;
+    openCorpusBuffer(&corpus, CORPUS, sizeof(CORPUS) - 1);
+
+    CHECK(nextPuzzle(&corpus, &puzzle) && corpus.lineNumber == 1 && matchesInitial(&puzzle));
+    CHECK(nextPuzzle(&corpus, &puzzle) && corpus.lineNumber == 4 && matchesInitial(&puzzle));
+    CHECK(corpus.lineLength == 81 + 9);  // Trailing text kept for the caller, '\r' dropped
+    CHECK(nextPuzzle(&corpus, &puzzle) && corpus.lineNumber == 9 && matchesInitial(&puzzle));
+    CHECK(nextPuzzle(&corpus, &puzzle) == 0);
+    CHECK(corpus.invalidLines == 4);
+    closeCorpus(&corpus);
+}
+
+static void testNextLine(void) {
+    static const LineKind EXPECTED[] = {
+        LINE_PUZZLE, LINE_EMPTY, LINE_EMPTY, LINE_PUZZLE, LINE_MALFORMED,
+        LINE_MALFORMED, LINE_MALFORMED, LINE_PUZZLE, LINE_PUZZLE
+    };
+    PuzzleCorpus corpus;
+    CompactPuzzle puzzle;
+    LineKind kind;
+    openCorpusBuffer(&corpus, CORPUS, sizeof(CORPUS) - 1);
+    corpus.validateClues = 0;  // Line 8 is then an ordinary puzzle
+
+    int lines = 0;
+    while(nextLine(&corpus, &puzzle, &kind)) {
+        CHECK(lines < 9 && kind == EXPECTED[lines]);
+        lines++;
+        CHECK(corpus.lineNumber == lines);
+    }
+    CHECK(lines == 9);
+    CHECK(corpus.invalidLines == 3);
+    closeCorpus(&corpus);
+}
+
+// Boundaries alone, then the same classification from the raw line
+static void testRawLines(void) {
+    PuzzleCorpus corpus;
+    CompactPuzzle puzzle;
+    openCorpusBuffer(&corpus, CORPUS, sizeof(CORPUS) - 1);
+
+    int lines = 0, puzzles = 0;
+    while(nextRawLine(&corpus)) {
+        lines++;
+        if(parseLine(corpus.line, corpus.lineLength, 1, &puzzle) == LINE_PUZZLE) {
+            puzzles++;
+            CHECK(matchesInitial(&puzzle));
+        }
+    }
+    CHECK(lines == 9 && puzzles == 3);
+    CHECK(corpus.invalidLines == 0);  // Counting is left to nextLine()
+    CHECK(parseLine(CLASH, 81, 0, &puzzle) == LINE_PUZZLE);
+    CHECK(parseLine(CLASH, 81, 1, &puzzle) == LINE_MALFORMED);
+    CHECK(parseLine("# note", 6, 1, &puzzle) == LINE_EMPTY);
+    closeCorpus(&corpus);
+}
+
+static void testFileRoundTrip(void) {
+    const char* path = "test_puzzle_io.txt";
+    ResultWriter writer;
+    CHECK(openResultWriter(&writer, path));
+    writeGrid(&writer, INITIAL_PUZZLE);
+    writeText(&writer, "# note\n", 7);
+    writeGrid(&writer, INITIAL_PUZZLE);
+    CHECK(closeResultWriter(&writer));
+
+    PuzzleCorpus corpus;
+    CompactPuzzle puzzle;
+    CHECK(openCorpus(&corpus, path));
+    int count = 0;
+    while(nextPuzzle(&corpus, &puzzle)) {
+        CHECK(matchesInitial(&puzzle));
+        count++;
+    }
+    CHECK(count == 2 && corpus.lineNumber == 3 && corpus.invalidLines == 0);
+    closeCorpus(&corpus);
+    remove(path);
+
+    CHECK(openCorpus(&corpus, "no/such/file.txt") == 0);
+}
+
+int main(void) {
+    testNextPuzzle();
+    testNextLine();
+    testRawLines();
+    testFileRoundTrip();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,83 @@
+#include "sudoku.h"
+#include "parameters.h"
+#include "board_operations.h"
+#include "solver.h"
+#include "check.h"
+
+// Solve briefly and check the result stays a board of the puzzle
+static void checkShortSolve(SudokuSolver* solver) {
+    SolveResult result = solve(solver, INITIAL_PUZZLE);
+    CHECK(result.reason != STOP_NONE);
+    CHECK(result.best.fitness > 0 && result.best.fitness <= 243);
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            if(INITIAL_PUZZLE[row][col]) CHECK(result.best.board[row][col] == INITIAL_PUZZLE[row][col]);
+        }
+    }
+}
+
+// Out-of-range parameters from a library caller are clamped, not trusted
+static void testValidatedParameters(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.verbose = 0;
+    parameters.maxEvaluations = 500;
+    parameters.populationSize = 3000;
+    parameters.eliteCount = 300;
+    parameters.steadyStateChildren = 40;
+    parameters.crossover = (CrossoverType)99;
+    parameters.mutation = (MutationType)-3;
+
+    SudokuSolver* solver = createSolver(&parameters);
+    CHECK(solver != NULL);
+    if(!solver) return;
+    setSolverSeed(solver, 3);
+
+    const GAParameters* used = getSolverParameters(solver);
+    CHECK(used->populationSize == MAX_POPULATION_SIZE);
+    CHECK(used->eliteCount == 300);
+    CHECK(used->steadyStateChildren == MAX_STEADY_STATE_CHILDREN);
+    CHECK(used->crossover == SINGLE_POINT && used->mutation == ROW_SWAP);
+    checkShortSolve(solver);
+
+    // Elites beyond the population and a steady state with too many children
+    parameters.populationSize = 20;
+    parameters.eliteCount = 300;
+    parameters.evolutionMode = STEADY_STATE;
+    CHECK(setSolverParameters(solver, &parameters));
+    CHECK(used->eliteCount == 19 && used->steadyStateChildren == 16);
+    checkShortSolve(solver);
+
+    parameters.evolutionMode = GENERATIONAL;
+    CHECK(setSolverParameters(solver, &parameters));
+    checkShortSolve(solver);
+
+    destroySolver(solver);
+}
+
+// A cancel that arrives after a solve has returned must not stop the next one
+static void testLateCancel(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.verbose = 0;
+    parameters.maxEvaluations = 500;
+
+    SudokuSolver* solver = createSolver(&parameters);
+    CHECK(solver != NULL);
+    if(!solver) return;
+    setSolverSeed(solver, 5);
+
+    checkShortSolve(solver);
+    cancelSolve(solver);
+    SolveResult result = solve(solver, INITIAL_PUZZLE);
+    CHECK(result.reason != STOP_CANCELLED);
+    CHECK(result.generations > 0);
+
+    destroySolver(solver);
+}
+
+int main(void) {
+    testValidatedParameters();
+    testLateCancel();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,38 @@
+#include "sudoku.h"
+#include "parameters.h"
+#include "board_operations.h"
+#include "population.h"
+#include "evolution.h"
+#include "rng.h"
+#include "check.h"
+
+// The engine bounds the children per step itself, whatever the parameters
+// say - evolve() may be called without validateParameters()
+static void testChildCountBound(void) {
+    GAParameters parameters;
+    setDefaultParameters(&parameters);
+    parameters.verbose = 0;
+    parameters.evolutionMode = STEADY_STATE;
+    parameters.steadyStateChildren = 40;
+    parameters.maxEvaluations = 2000;
+
+    RandomState random;
+    seedRandom(&random, 5);
+    Population* population = createPopulation(100, &random);
+    CHECK(population != NULL);
+    if(!population) return;
+
+    SolveState state = {0};
+    state.parameters = &parameters;
+    state.random = &random;
+    SolveResult result = evolve(&state, population, TOURNAMENT, SINGLE_POINT, ROW_SWAP);
+    CHECK(result.reason == STOP_EVALUATION_LIMIT || result.reason == STOP_SOLVED);
+    CHECK(result.best.fitness > 0 && result.best.fitness <= 243);
+
+    destroyPopulation(population);
+}
+
+int main(void) {
+    testChildCountBound();
+    return CHECK_RESULT();
+}
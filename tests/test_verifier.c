@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <string.h>
+#include "sudoku.h"
+#include "board_operations.h"
+#include "exact_solver.h"
+#include "puzzle_io.h"
+#include "verifier.h"
+#include "check.h"
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+
+static CompactPuzzle puzzle, solution;
+
+static unsigned int unitBits(int shift, int unit) {
+    return 1u << (shift + unit);
+}
+
+static void testVerifySolution(void) {
+    CHECK(verifySolution(&puzzle, &solution) == 0);
+
+    // Two free cells of row 0 swapped: the row still holds 1..9, their
+    // columns do not; both cells are in block 0
+    CompactPuzzle swapped = solution;
+    swapped.cells[2] = solution.cells[3];
+    swapped.cells[3] = solution.cells[2];
+    CHECK(verifySolution(&puzzle, &swapped) ==
+          (unitBits(VERIFY_COLUMN_SHIFT, 2) | unitBits(VERIFY_COLUMN_SHIFT, 3) |
+           unitBits(VERIFY_BLOCK_SHIFT, 0) | unitBits(VERIFY_BLOCK_SHIFT, 1)));
+
+    // A clue replaced by a digit swapped in from its row
+    swapped = solution;
+    swapped.cells[0] = solution.cells[2];
+    swapped.cells[2] = solution.cells[0];
+    CHECK(verifySolution(&puzzle, &swapped) & VERIFY_CLUE_MISMATCH);
+
+    // Empty and out-of-range cells fail their row, column and block
+    unsigned int lastCell = unitBits(VERIFY_ROW_SHIFT, 8) | unitBits(VERIFY_COLUMN_SHIFT, 8) |
+                            unitBits(VERIFY_BLOCK_SHIFT, 8);
+    CompactPuzzle broken = solution;
+    broken.cells[CELL_COUNT - 1] = 0;
+    CHECK((verifySolution(&puzzle, &broken) & ~VERIFY_CLUE_MISMATCH) == lastCell);
+    broken.cells[CELL_COUNT - 1] = 12;
+    CHECK((verifySolution(&puzzle, &broken) & ~VERIFY_CLUE_MISMATCH) == lastCell);
+
+    // Bytes from a caller's buffer never alias digits (17 is not 1)
+    broken = solution;
+    for(int i = 0; i < CELL_COUNT; i++) {
+        if(!puzzle.cells[i]) broken.cells[i] = (unsigned char)(solution.cells[i] + 16);
+    }
+    CHECK(verifySolution(&puzzle, &broken) == (VERIFY_UNIT_MASK << VERIFY_ROW_SHIFT |
+                                               VERIFY_UNIT_MASK << VERIFY_COLUMN_SHIFT |
+                                               VERIFY_UNIT_MASK << VERIFY_BLOCK_SHIFT));
+}
+
+static void testVerifySolutions(void) {
+    enum { COUNT = 21 };
+    CompactPuzzle puzzles[COUNT], solutions[COUNT];
+    unsigned int diagnostics[COUNT];
+    unsigned char bitmap[(COUNT + 7) / 8];
+    for(int i = 0; i < COUNT; i++) {
+        puzzles[i] = puzzle;
+        solutions[i] = solution;
+    }
+    solutions[3].cells[40] = 0;
+    solutions[8].cells[0] = 0;
+    solutions[20].cells[80] = 0;
+
+    CHECK(verifySolutions(puzzles, solutions, COUNT, diagnostics, bitmap) == 3);
+    CHECK(bitmap[0] == 0xF7 && bitmap[1] == 0xFE && bitmap[2] == 0x0F);
+    CHECK(diagnostics[0] == 0 && diagnostics[3] != 0 && diagnostics[8] != 0 && diagnostics[20] != 0);
+
+    // Split between threads the result is the same
+    unsigned int parallelDiagnostics[COUNT];
+    unsigned char parallelBitmap[(COUNT + 7) / 8];
+    CHECK(verifyInParallel(puzzles, solutions, COUNT, parallelDiagnostics, parallelBitmap, 4) == 3);
+    CHECK(memcmp(diagnostics, parallelDiagnostics, sizeof(diagnostics)) == 0);
+    CHECK(parallelBitmap[0] == bitmap[0] && parallelBitmap[1] == bitmap[1] &&
+          parallelBitmap[2] == bitmap[2]);
+}
+
+// Read a whole small file into text; returns its length
+static size_t readFile(const char* path, char* text, size_t size) {
+    FILE* file = fopen(path, "rb");
+    if(!file) return 0;
+    size_t length = fread(text, 1, size - 1, file);
+    fclose(file);
+    text[length] = 0;
+    return length;
+}
+
+static void testVerifyCorpora(void) {
+    char puzzleLine[CELL_COUNT + 1], solutionLine[CELL_COUNT + 1], badSolution[CELL_COUNT + 1];
+    for(int i = 0; i < CELL_COUNT; i++) {
+        puzzleLine[i] = puzzle.cells[i] ? (char)('0' + puzzle.cells[i]) : '.';
+        solutionLine[i] = (char)('0' + solution.cells[i]);
+    }
+    puzzleLine[CELL_COUNT] = solutionLine[CELL_COUNT] = 0;
+    memcpy(badSolution, solutionLine, sizeof(badSolution));
+    badSolution[CELL_COUNT - 1] = '.';
+
+    // Line 2 malformed puzzle, line 3 blank on both sides, line 4 a clue
+    // cleared in the solution, line 5 a solution without its puzzle; one
+    // surplus puzzle
+    char puzzles[1024], solutions[1024];
+    snprintf(puzzles, sizeof(puzzles), "%s\nnot a puzzle\n\n%s\n\n%s\n%s\n",
+             puzzleLine, puzzleLine, puzzleLine, puzzleLine);
+    snprintf(solutions, sizeof(solutions), "%s\n%s\n# none\n%s\n%s\n%s\n",
+             solutionLine, solutionLine, badSolution, solutionLine, solutionLine);
+
+    PuzzleCorpus puzzleCorpus, solutionCorpus;
+    openCorpusBuffer(&puzzleCorpus, puzzles, strlen(puzzles));
+    openCorpusBuffer(&solutionCorpus, solutions, strlen(solutions));
+
+    const char* reportPath = "test_verifier_report.txt";
+    const char* bitmapPath = "test_verifier_bitmap.bin";
+    ResultWriter report, bitmap;
+    CHECK(openResultWriter(&report, reportPath) && openResultWriter(&bitmap, bitmapPath));
+
+    VerifyStats stats;
+    verifyCorpora(&puzzleCorpus, &solutionCorpus, 2, &report, &bitmap, &stats);
+    CHECK(closeResultWriter(&report) && closeResultWriter(&bitmap));
+    closeCorpus(&puzzleCorpus);
+    closeCorpus(&solutionCorpus);
+
+    CHECK(stats.lines == 6 && stats.checked == 5 && stats.failed == 3);
+    CHECK(stats.malformedPuzzles == 2 && stats.malformedSolutions == 0);
+    CHECK(stats.badRows == 1 && stats.badColumns == 1 && stats.badBlocks == 1);
+    CHECK(stats.surplusPuzzles == 1 && stats.surplusSolutions == 0);
+
+    char text[512];
+    readFile(reportPath, text, sizeof(text));
+    CHECK(strcmp(text, "2 malformed puzzle\n"
+                       "4 rows=100 cols=100 blocks=100 clues\n"
+                       "5 malformed puzzle\n") == 0);
+    CHECK(readFile(bitmapPath, text, sizeof(text)) == 1 && (unsigned char)text[0] == 0x25);
+
+    remove(reportPath);
+    remove(bitmapPath);
+}
+
+int main(void) {
+    int grid[BOARD_SIZE][BOARD_SIZE];
+    compactGrid(INITIAL_PUZZLE, &puzzle);
+    solveExact(INITIAL_PUZZLE, grid);
+    compactGrid((const int (*)[BOARD_SIZE])grid, &solution);
+
+    testVerifySolution();
+    testVerifySolutions();
+    testVerifyCorpora();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,8 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+// Time measurement
+double cpuTimeSeconds(void);
+double wallTimeSeconds(void);
+
+#endif
@@ -0,0 +1,416 @@
+// Parameter autotuner - searches population size, rates and operators with
+// successive halving over a puzzle corpus and writes the winning configuration
+// in the format loaded by the solver (see parameters.c).
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "sudoku.h"
+#include "parameters.h"
+#include "puzzle_io.h"
+#include "timing.h"
+#include "solver.h"
+
+#define INITIAL_CANDIDATES 32   // Configurations in the first round
+#define INITIAL_RUNS 2          // Puzzles per configuration in the first round
+#define MAX_RUNS_PER_ROUND 1024 // Keeps a worker's results within one pipe buffer
+#define RUN_CUTOFF 10.0         // Default wall-clock limit of one run (seconds)
+#define PAR_FACTOR 10.0         // Unsolved runs score this multiple of the cutoff (PAR-10)
+#define MAX_JOBS 256
+
+typedef struct {
+    GAParameters parameters;
+    double score;     // Mean or p95 penalized time to solution (lower is better)
+    int solved;       // Runs solved in the last round
+    int runs;         // Runs in the last round
+} Candidate;
+
+typedef struct {
+    double seconds;
+    int solved;
+    int cutShort;     // Unsolved because the tuning deadline came before the cutoff
+} RunResult;
+
+typedef struct {
+    CompactPuzzle* puzzles;
+    int count;
+} Corpus;
+
+typedef enum {
+    METRIC_MEAN,
+    METRIC_P95
+} TuningMetric;
+
+static void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s <puzzle-file> <budget-seconds> [options]\n", program);
+    fprintf(stderr, "  -o <file>   output configuration (default sudoku.cfg)\n");
+    fprintf(stderr, "  -j <jobs>   parallel workers (default: number of cores)\n");
+    fprintf(stderr, "  -m mean|p95 metric to minimize (default mean)\n");
+    fprintf(stderr, "  -c <count>  configurations in the first round (default %d)\n", INITIAL_CANDIDATES);
+    fprintf(stderr, "  -t <seconds> time limit of one run; unsolved runs score %.0fx this (default %.0f)\n",
+            PAR_FACTOR, RUN_CUTOFF);
+    fprintf(stderr, "  -s <seed>   random seed\n");
+}
+
+// Load every valid puzzle of the corpus in compact form
+static int loadCorpus(const char* path, Corpus* corpus) {
+    PuzzleCorpus reader;
+    if(!openCorpus(&reader, path)) return 0;
+
+    int capacity = 1024;
+    corpus->count = 0;
+    corpus->puzzles = malloc(capacity * sizeof(CompactPuzzle));
+
+    CompactPuzzle puzzle;
+    while(corpus->puzzles && nextPuzzle(&reader, &puzzle)) {
+        if(corpus->count == capacity) {
+            capacity *= 2;
+            void* grown = realloc(corpus->puzzles, capacity * sizeof(CompactPuzzle));
+            if(!grown) break;
+            corpus->puzzles = grown;
+        }
+        corpus->puzzles[corpus->count++] = puzzle;
+    }
+
+    if(reader.invalidLines > 0) {
+        fprintf(stderr, "%s: skipped %ld invalid lines\n", path, reader.invalidLines);
+    }
+    closeCorpus(&reader);
+    return corpus->count > 0;
+}
+
+static double randomRange(double low, double high) {
+    return low + (high - low) * rand() / (double)RAND_MAX;
+}
+
+// Draw a configuration from the search space
+static void randomCandidate(GAParameters* parameters) {
+    static const int populationSizes[] = {50, 100, 200, 400, 800};
+    static const int tournamentSizes[] = {2, 3, 5, 10, 20};
+    static const int eliteCounts[] = {0, 2, 4, 8, 16};
+
+    parameters->populationSize = populationSizes[rand() % 5];
+    parameters->tournamentSize = tournamentSizes[rand() % 5];
+    parameters->eliteCount = eliteCounts[rand() % 5];
+    parameters->crossoverRate = randomRange(0.5, 1.0);
+    parameters->mutationRate = randomRange(0.05, 0.8);
+    parameters->adaptiveRates = rand() % 2;
+    parameters->selection = (SelectionType)(rand() % (RANKING + 1));
+    parameters->crossover = (CrossoverType)(rand() % (ADAPTIVE_CROSSOVER + 1));
+    parameters->mutation = (MutationType)(rand() % (ADAPTIVE_MUTATION + 1));
+    parameters->evolutionMode = (EvolutionMode)(rand() % (STEADY_STATE + 1));
+    parameters->replacement = (ReplacementPolicy)(rand() % (REPLACE_TOURNAMENT_LOSER + 1));
+    parameters->steadyStateChildren = 1 + rand() % 4;
+}
+
+// Solve the given puzzles with one configuration (runs inside a worker process).
+// Each run stops at the cutoff or the tuning deadline, whichever comes first,
+// and then counts as unsolved. Runs stopped by the deadline are flagged so
+// the round can be discarded instead of scoring them as failures.
+static void runCandidate(Candidate* candidate, Corpus* corpus, const int* order,
+                         int firstRun, int runs, unsigned seed, double cutoff,
+                         double deadline, RunResult* results) {
+    GAParameters parameters = candidate->parameters;
+    parameters.verbose = 0;
+    parameters.hybridFinisher = 0;  // Measure the genetic algorithm itself
+    SudokuSolver* solver = createSolver(&parameters);
+    if(!solver) {
+        fprintf(stderr, "Failed to allocate solver!\n");
+        _exit(1);  // Worker process - its candidate is not scored
+    }
+    setSolverSeed(solver, seed);
+
+    for(int run = 0; run < runs; run++) {
+        int grid[BOARD_SIZE][BOARD_SIZE];
+        expandPuzzle(&corpus->puzzles[order[(firstRun + run) % corpus->count]], grid);
+        double start = wallTimeSeconds();
+
+        double remaining = deadline - start > 0.001 ? deadline - start : 0.001;
+        parameters.timeLimit = remaining < cutoff ? remaining : cutoff;
+        setSolverParameters(solver, &parameters);
+
+        SolveResult result = solve(solver, grid);
+
+        results[run].seconds = wallTimeSeconds() - start;
+        results[run].solved = result.best.fitness == 243;
+        results[run].cutShort = !results[run].solved && parameters.timeLimit < cutoff;
+    }
+
+    destroySolver(solver);
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Penalized average runtime (PAR-k): an unsolved run costs PAR_FACTOR times
+// the cutoff however soon it gave up, so stopping early never pays off
+static double scoreRuns(RunResult* results, int runs, TuningMetric metric, double cutoff, int* solved) {
+    double times[MAX_RUNS_PER_ROUND];
+    double sum = 0.0;
+    *solved = 0;
+
+    for(int i = 0; i < runs; i++) {
+        times[i] = results[i].solved ? results[i].seconds : PAR_FACTOR * cutoff;
+        sum += times[i];
+        *solved += results[i].solved;
+    }
+
+    if(metric == METRIC_MEAN) return sum / runs;
+
+    qsort(times, runs, sizeof(double), compareDoubles);
+    int index = (int)ceil(0.95 * runs) - 1;
+    return times[index < 0 ? 0 : index];
+}
+
+static int readResults(int fd, RunResult* results, int runs) {
+    size_t expected = runs * sizeof(RunResult);
+    size_t received = 0;
+    while(received < expected) {
+        ssize_t n = read(fd, (char*)results + received, expected - received);
+        if(n <= 0) break;
+        received += n;
+    }
+    return received == expected;
+}
+
+// Evaluate every candidate on the same runs, one worker process per candidate.
+// Candidates not started before the deadline get an infinite score.
+// Returns 1 if every candidate was started and none of its runs was cut short
+// by the deadline, i.e. the scores can be compared fairly.
+static int evaluateRound(Candidate* candidates, int count, Corpus* corpus, const int* order,
+                         int firstRun, int runs, int jobs, TuningMetric metric,
+                         double cutoff, double deadline, unsigned seed) {
+    pid_t pids[MAX_JOBS];
+    int fds[MAX_JOBS];
+    int owners[MAX_JOBS];
+    int running = 0;
+    int next = 0;
+    int complete = 1;
+
+    for(int i = 0; i < count; i++) candidates[i].score = INFINITY;
+
+    while(next < count || running > 0) {
+        // Start workers while there is room and time
+        while(running < jobs && next < count && wallTimeSeconds() < deadline) {
+            int pipeFds[2];
+            if(pipe(pipeFds) != 0) break;
+
+            pid_t pid = fork();
+            if(pid < 0) {
+                close(pipeFds[0]);
+                close(pipeFds[1]);
+                break;
+            }
+            if(pid == 0) {
+                RunResult results[MAX_RUNS_PER_ROUND];
+                close(pipeFds[0]);
+                runCandidate(&candidates[next], corpus, order, firstRun, runs,
+                             seed + next * 7919u, cutoff, deadline, results);
+                ssize_t written = write(pipeFds[1], results, runs * sizeof(RunResult));
+                _exit(written == (ssize_t)(runs * sizeof(RunResult)) ? 0 : 1);
+            }
+
+            close(pipeFds[1]);
+            pids[running] = pid;
+            fds[running] = pipeFds[0];
+            owners[running] = next;
+            running++;
+            next++;
+        }
+
+        if(running == 0) break;
+
+        // Results fit in the pipe buffer, so a finished worker never blocks on write
+        int status;
+        pid_t done = waitpid(-1, &status, 0);
+        if(done < 0) break;
+
+        for(int slot = 0; slot < running; slot++) {
+            if(pids[slot] != done) continue;
+
+            RunResult results[MAX_RUNS_PER_ROUND];
+            Candidate* candidate = &candidates[owners[slot]];
+            if(readResults(fds[slot], results, runs)) {
+                candidate->score = scoreRuns(results, runs, metric, cutoff, &candidate->solved);
+                candidate->runs = runs;
+                for(int run = 0; run < runs; run++) {
+                    if(results[run].cutShort) complete = 0;
+                }
+            }
+            close(fds[slot]);
+
+            running--;
+            pids[slot] = pids[running];
+            fds[slot] = fds[running];
+            owners[slot] = owners[running];
+            break;
+        }
+    }
+
+    return complete && next == count;
+}
+
+// More solved runs first, then lower penalized time
+static int compareCandidates(const void* a, const void* b) {
+    const Candidate* x = (const Candidate*)a;
+    const Candidate* y = (const Candidate*)b;
+    if(x->score == INFINITY || y->score == INFINITY) {
+        return (x->score > y->score) - (x->score < y->score);
+    }
+    if(x->solved != y->solved) return y->solved - x->solved;
+    return (x->score > y->score) - (x->score < y->score);
+}
+
+static void printCandidate(const Candidate* candidate) {
+    const GAParameters* p = &candidate->parameters;
+    printf("  %8.4fs  solved %4d/%-4d  pop %4d  tour %2d  elite %2d  cx %.2f  mut %.2f  adaptive %d  %s/%s/%s\n",
+           candidate->score, candidate->solved, candidate->runs,
+           p->populationSize, p->tournamentSize, p->eliteCount,
+           p->crossoverRate, p->mutationRate, p->adaptiveRates,
+           p->selection == TOURNAMENT ? "Tournament" : p->selection == ROULETTE ? "Roulette" : "Ranking",
+           crossoverName(p->crossover), mutationName(p->mutation));
+}
+
+int main(int argc, char* argv[]) {
+    if(argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const char* corpusPath = argv[1];
+    double budget = atof(argv[2]);
+    const char* outputPath = "sudoku.cfg";
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = cores > 0 ? (int)cores : 1;
+    TuningMetric metric = METRIC_MEAN;
+    int candidateCount = INITIAL_CANDIDATES;
+    unsigned seed = (unsigned)time(NULL);
+    double cutoff = RUN_CUTOFF;
+
+    for(int i = 3; i < argc; i++) {
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) outputPath = argv[++i];
+        else if(strcmp(argv[i], "-j") == 0 && i + 1 < argc) jobs = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            metric = strcmp(argv[++i], "p95") == 0 ? METRIC_P95 : METRIC_MEAN;
+        else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) candidateCount = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = (unsigned)atol(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) cutoff = atof(argv[++i]);
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if(jobs < 1) jobs = 1;
+    if(jobs > MAX_JOBS) jobs = MAX_JOBS;
+    if(candidateCount < 1) candidateCount = 1;
+    if(budget <= 0.0 || cutoff <= 0.0) {
+        fprintf(stderr, "Budget and run time limit must be positive\n");
+        return 1;
+    }
+
+    Corpus corpus;
+    if(!loadCorpus(corpusPath, &corpus)) {
+        fprintf(stderr, "Cannot read puzzles from %s\n", corpusPath);
+        return 1;
+    }
+
+    // Puzzle order shuffled once - every round continues through it
+    srand(seed);
+    int* order = malloc(corpus.count * sizeof(int));
+    Candidate* candidates = malloc(candidateCount * sizeof(Candidate));
+    if(!order || !candidates) {
+        fprintf(stderr, "Failed to allocate tuner state!\n");
+        return 1;
+    }
+    for(int i = 0; i < corpus.count; i++) order[i] = i;
+    for(int i = corpus.count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+
+    // The current configuration always competes
+    GAParameters defaults;
+    setDefaultParameters(&defaults);
+    for(int i = 0; i < candidateCount; i++) {
+        candidates[i].parameters = defaults;
+        candidates[i].score = INFINITY;
+        candidates[i].solved = 0;
+        candidates[i].runs = 0;
+        if(i > 0) randomCandidate(&candidates[i].parameters);
+    }
+
+    printf("Tuning on %d puzzles, %d configurations, %d workers, %.0fs budget, %.1fs per run (PAR-%.0f %s)\n",
+           corpus.count, candidateCount, jobs, budget, cutoff, PAR_FACTOR,
+           metric == METRIC_MEAN ? "mean" : "p95");
+
+    // Successive halving: double the runs, keep the better half
+    double deadline = wallTimeSeconds() + budget;
+    int alive = candidateCount;
+    int runs = INITIAL_RUNS;
+    int firstRun = 0;
+    int rankedRound = 0;
+    for(int round = 1; alive > 1 && wallTimeSeconds() < deadline; round++) {
+        Candidate* previous = malloc(alive * sizeof(Candidate));
+        if(previous) memcpy(previous, candidates, alive * sizeof(Candidate));
+
+        int complete = evaluateRound(candidates, alive, &corpus, order, firstRun, runs,
+                                     jobs, metric, cutoff, deadline, seed + round * 104729u);
+        if(!complete) {
+            // The deadline cut this round short - late candidates would score as
+            // failures, so keep the previous ranking
+            if(previous) memcpy(candidates, previous, alive * sizeof(Candidate));
+            free(previous);
+            break;
+        }
+        free(previous);
+
+        qsort(candidates, alive, sizeof(Candidate), compareCandidates);
+        printf("\nRound %d: %d configurations x %d puzzles\n", round, alive, runs);
+        for(int i = 0; i < alive && i < 5 && candidates[i].score < INFINITY; i++) {
+            printCandidate(&candidates[i]);
+        }
+        rankedRound = round;
+
+        firstRun += runs;
+        alive = (alive + 1) / 2;
+        if(runs * 2 <= MAX_RUNS_PER_ROUND) runs *= 2;
+    }
+
+    if(rankedRound == 0) {
+        fprintf(stderr, "Budget too small - no configuration was evaluated\n");
+        return 1;
+    }
+
+    // A configuration that solved nothing is no better than a random guess
+    if(candidates[0].solved == 0) {
+        fprintf(stderr, "No configuration solved a puzzle in round %d - %s not written\n",
+                rankedRound, outputPath);
+        fprintf(stderr, "Try a larger budget, a longer run time limit (-t) or easier puzzles\n");
+        return 1;
+    }
+
+    GAParameters winner = candidates[0].parameters;
+    winner.hybridFinisher = defaults.hybridFinisher;
+    winner.verbose = 1;
+    if(!saveParameters(outputPath, &winner)) {
+        fprintf(stderr, "Cannot write %s\n", outputPath);
+        return 1;
+    }
+
+    printf("\nBest configuration written to %s:\n", outputPath);
+    printCandidate(&candidates[0]);
+
+    free(candidates);
+    free(order);
+    free(corpus.puzzles);
+    return 0;
+}
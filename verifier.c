@@ -0,0 +1,325 @@
+#include "verifier.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "sudoku.h"
+#include "puzzle_io.h"
+#include "timing.h"
+
+#define CELL_COUNT (BOARD_SIZE * BOARD_SIZE)
+#define ALL_DIGITS 0x3FE  // Bits 1..9 set - one bit per digit
+
+// Cell value -> digit bit. Every byte outside 1..9 (empty cells, and any
+// value a caller's buffer may hold) maps to no bit, which leaves its units
+// one digit short.
+static const unsigned short DIGIT_BIT[256] = {
+    0, 1u << 1, 1u << 2, 1u << 3, 1u << 4, 1u << 5, 1u << 6, 1u << 7, 1u << 8, 1u << 9
+};
+
+
+// === SOLUTION VERIFIER ===
+
+// Check one solution against its puzzle. Nine cells whose digit bits OR to
+// ALL_DIGITS hold every digit exactly once, so each unit is a single OR
+// reduction - no counting and no branch per cell. Returns 0 for a valid
+// solution, otherwise the VERIFY_* bits of the failed units and clues.
+unsigned int verifySolution(const CompactPuzzle* puzzle, const CompactPuzzle* solution) {
+    unsigned short bits[CELL_COUNT];
+    for(int i = 0; i < CELL_COUNT; i++) {
+        bits[i] = DIGIT_BIT[solution->cells[i]];
+    }
+
+    // Clues must be kept (byte-wise compare of the whole grid)
+    unsigned char changed = 0;
+    for(int i = 0; i < CELL_COUNT; i++) {
+        unsigned char clue = puzzle->cells[i];
+        changed |= (unsigned char)((clue != 0) & (clue != solution->cells[i]));
+    }
+
+    unsigned short rows[BOARD_SIZE], cols[BOARD_SIZE], blocks[BOARD_SIZE];
+    memset(cols, 0, sizeof(cols));
+    memset(blocks, 0, sizeof(blocks));
+    for(int row = 0; row < BOARD_SIZE; row++) {
+        const unsigned short* line = bits + row * BOARD_SIZE;
+        unsigned short rowBits = 0;
+        for(int col = 0; col < BOARD_SIZE; col++) {
+            rowBits |= line[col];
+            cols[col] |= line[col];
+        }
+        rows[row] = rowBits;
+
+        unsigned short* band = blocks + (row / BLOCK_SIZE) * BLOCK_SIZE;
+        band[0] |= line[0] | line[1] | line[2];
+        band[1] |= line[3] | line[4] | line[5];
+        band[2] |= line[6] | line[7] | line[8];
+    }
+
+    unsigned int diagnostic = changed ? VERIFY_CLUE_MISMATCH : 0;
+    for(int unit = 0; unit < BOARD_SIZE; unit++) {
+        diagnostic |= (unsigned int)(rows[unit] != ALL_DIGITS) << (VERIFY_ROW_SHIFT + unit);
+        diagnostic |= (unsigned int)(cols[unit] != ALL_DIGITS) << (VERIFY_COLUMN_SHIFT + unit);
+        diagnostic |= (unsigned int)(blocks[unit] != ALL_DIGITS) << (VERIFY_BLOCK_SHIFT + unit);
+    }
+    return diagnostic;
+}
+
+// Check count solutions against their puzzles, held in memory. Writes each
+// diagnostic word (if diagnostics is not NULL) and sets bit i of passBitmap
+// (least significant bit first, if not NULL) for every solution that passes.
+// Ranges starting at multiples of 8 touch separate bitmap bytes, so threads
+// can verify them concurrently. Returns the number of failed solutions.
+long verifySolutions(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                     unsigned int* diagnostics, unsigned char* passBitmap) {
+    long failed = 0;
+    unsigned char passBits = 0;
+
+    for(long i = 0; i < count; i++) {
+        unsigned int diagnostic = verifySolution(&puzzles[i], &solutions[i]);
+        if(diagnostics) diagnostics[i] = diagnostic;
+        failed += diagnostic != 0;
+        passBits |= (unsigned char)((diagnostic == 0) << (i & 7));
+
+        if((i & 7) == 7 || i == count - 1) {
+            if(passBitmap) passBitmap[i >> 3] = passBits;
+            passBits = 0;
+        }
+    }
+
+    return failed;
+}
+
+
+// === PARALLEL VERIFICATION ===
+
+// Run jobCount jobs of jobSize bytes each, one thread per job; the calling
+// thread takes the first job and any job whose thread failed to start
+static void runJobs(void* jobs, size_t jobSize, int jobCount, void* (*run)(void*)) {
+    pthread_t handles[MAX_WORKER_THREADS];
+    int started[MAX_WORKER_THREADS];
+    char* job = (char*)jobs;
+
+    for(int i = 0; i < jobCount; i++) {
+        started[i] = i > 0 && pthread_create(&handles[i], NULL, run, job + i * jobSize) == 0;
+    }
+    for(int i = 0; i < jobCount; i++) {
+        if(!started[i]) run(job + i * jobSize);
+    }
+    for(int i = 0; i < jobCount; i++) {
+        if(started[i]) pthread_join(handles[i], NULL);
+    }
+}
+
+// Entries per thread: an even split rounded up to a multiple of 8, so each
+// share writes its own bitmap bytes
+static long shareSize(long count, int threads) {
+    if(threads < 1) threads = 1;
+    if(threads > MAX_WORKER_THREADS) threads = MAX_WORKER_THREADS;
+    return ((count + threads - 1) / threads + 7) & ~7L;
+}
+
+// One thread's share of a verification round
+typedef struct {
+    const CompactPuzzle* puzzles;
+    const CompactPuzzle* solutions;
+    unsigned int* diagnostics;
+    unsigned char* passBitmap;
+    long count;
+    long failed;
+} VerifyJob;
+
+static void* runVerifyJob(void* argument) {
+    VerifyJob* job = (VerifyJob*)argument;
+    job->failed = verifySolutions(job->puzzles, job->solutions, job->count,
+                                  job->diagnostics, job->passBitmap);
+    return NULL;
+}
+
+// verifySolutions() on up to threads threads; shares start at multiples of 8
+// so each thread writes its own bitmap bytes. Returns the failures.
+long verifyInParallel(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                      unsigned int* diagnostics, unsigned char* passBitmap, int threads) {
+    VerifyJob jobs[MAX_WORKER_THREADS];
+    long share = shareSize(count, threads);
+    int jobCount = 0;
+    for(long first = 0; first < count; first += share) {
+        VerifyJob* job = &jobs[jobCount++];
+        job->puzzles = puzzles + first;
+        job->solutions = solutions + first;
+        job->diagnostics = diagnostics ? diagnostics + first : NULL;
+        job->passBitmap = passBitmap ? passBitmap + first / 8 : NULL;
+        job->count = count - first < share ? count - first : share;
+        job->failed = 0;
+    }
+    runJobs(jobs, sizeof(VerifyJob), jobCount, runVerifyJob);
+
+    long failed = 0;
+    for(int i = 0; i < jobCount; i++) failed += jobs[i].failed;
+    return failed;
+}
+
+// Report line of a failed entry: "<line> rows=<mask> cols=<mask> blocks=<mask>"
+// with one hexadecimal bit per unit (" clues" appended if a clue was changed),
+// or "<line> malformed puzzle|solution" if a side could not be read.
+// Returns the length.
+int formatVerifyFailure(long line, unsigned int diagnostic, char* text, size_t size) {
+    if(diagnostic & (VERIFY_BAD_PUZZLE | VERIFY_BAD_SOLUTION)) {
+        return snprintf(text, size, "%ld malformed%s%s\n", line,
+                        (diagnostic & VERIFY_BAD_PUZZLE) ? " puzzle" : "",
+                        (diagnostic & VERIFY_BAD_SOLUTION) ? " solution" : "");
+    }
+    return snprintf(text, size, "%ld rows=%03x cols=%03x blocks=%03x%s\n", line,
+                    (diagnostic >> VERIFY_ROW_SHIFT) & VERIFY_UNIT_MASK,
+                    (diagnostic >> VERIFY_COLUMN_SHIFT) & VERIFY_UNIT_MASK,
+                    (diagnostic >> VERIFY_BLOCK_SHIFT) & VERIFY_UNIT_MASK,
+                    (diagnostic & VERIFY_CLUE_MISMATCH) ? " clues" : "");
+}
+
+// Diagnostic of a pair of blank or comment lines - passes, but was not checked
+#define ENTRY_BLANK (1u << 31)
+
+// One line pair as found by the reading thread (lines without their breaks)
+typedef struct {
+    const char* puzzle;
+    const char* solution;
+    size_t puzzleLength;
+    size_t solutionLength;
+} LinePair;
+
+// One thread's share of a corpus round: parse and check its line pairs
+typedef struct {
+    const LinePair* pairs;
+    unsigned int* diagnostics;
+    unsigned char* passBitmap;
+    long count;
+    int validateClues;  // Of the puzzle side; solutions are parsed without
+} CorpusJob;
+
+static void* runCorpusJob(void* argument) {
+    CorpusJob* job = (CorpusJob*)argument;
+    CompactPuzzle puzzle, solution;
+    unsigned char passBits = 0;
+
+    for(long i = 0; i < job->count; i++) {
+        const LinePair* pair = &job->pairs[i];
+        LineKind puzzleKind = parseLine(pair->puzzle, pair->puzzleLength, job->validateClues, &puzzle);
+        LineKind solutionKind = parseLine(pair->solution, pair->solutionLength, 0, &solution);
+
+        unsigned int diagnostic;
+        if(puzzleKind == LINE_PUZZLE && solutionKind == LINE_PUZZLE) {
+            diagnostic = verifySolution(&puzzle, &solution);
+        } else if(puzzleKind == LINE_EMPTY && solutionKind == LINE_EMPTY) {
+            diagnostic = ENTRY_BLANK;
+        } else {
+            diagnostic = (puzzleKind != LINE_PUZZLE ? VERIFY_BAD_PUZZLE : 0) |
+                         (solutionKind != LINE_PUZZLE ? VERIFY_BAD_SOLUTION : 0);
+        }
+        job->diagnostics[i] = diagnostic;
+        passBits |= (unsigned char)((diagnostic == 0 || diagnostic == ENTRY_BLANK) << (i & 7));
+
+        if((i & 7) == 7 || i == job->count - 1) {
+            job->passBitmap[i >> 3] = passBits;
+            passBits = 0;
+        }
+    }
+    return NULL;
+}
+
+// Blank and comment lines are not surplus
+static int lineHasContent(const PuzzleCorpus* corpus) {
+    return corpus->lineLength > 0 && corpus->line[0] != '#';
+}
+
+// Check the solutions of one corpus against the puzzles of another, line N
+// against line N, in rounds of VERIFY_CHUNK line pairs, so files of any size
+// stream through fixed buffers. The calling thread only finds the line
+// boundaries; parsing, clue validation and the checks run on up to threads
+// threads. A pair where either side is missing or malformed fails with
+// VERIFY_BAD_* bits; lines after the end of the shorter file are counted as
+// surplus. Failures go to report (formatVerifyFailure() lines) and bit i of
+// bitmap (least significant first) is set if line i + 1 passed; either may
+// be NULL. Solutions are parsed without clue validation. Fills stats.
+// Returns 1, or 0 if the buffers cannot be allocated.
+int verifyCorpora(PuzzleCorpus* puzzles, PuzzleCorpus* solutions, int threads,
+                  ResultWriter* report, ResultWriter* bitmap, VerifyStats* stats) {
+    memset(stats, 0, sizeof(VerifyStats));
+    LinePair* pairs = (LinePair*)malloc(VERIFY_CHUNK * sizeof(LinePair));
+    unsigned int* diagnostics = (unsigned int*)malloc(VERIFY_CHUNK * sizeof(unsigned int));
+    unsigned char* passBitmap = (unsigned char*)malloc(VERIFY_CHUNK / 8);
+    if(!pairs || !diagnostics || !passBitmap) {
+        free(pairs);
+        free(diagnostics);
+        free(passBitmap);
+        return 0;
+    }
+
+    double start = wallTimeSeconds();
+    int puzzlesLeft = 1, solutionsLeft = 1;
+    while(puzzlesLeft && solutionsLeft) {
+        // Collect a round of line pairs - boundaries only
+        long count = 0;
+        while(count < VERIFY_CHUNK) {
+            puzzlesLeft = nextRawLine(puzzles);
+            solutionsLeft = nextRawLine(solutions);
+            if(!puzzlesLeft || !solutionsLeft) {
+                // The line read from the longer file is its first surplus line
+                stats->surplusPuzzles += puzzlesLeft && lineHasContent(puzzles);
+                stats->surplusSolutions += solutionsLeft && lineHasContent(solutions);
+                break;
+            }
+
+            pairs[count].puzzle = puzzles->line;
+            pairs[count].puzzleLength = puzzles->lineLength;
+            pairs[count].solution = solutions->line;
+            pairs[count].solutionLength = solutions->lineLength;
+            count++;
+        }
+        if(count == 0) break;
+
+        CorpusJob jobs[MAX_WORKER_THREADS];
+        long share = shareSize(count, threads);
+        int jobCount = 0;
+        for(long first = 0; first < count; first += share) {
+            CorpusJob* job = &jobs[jobCount++];
+            job->pairs = pairs + first;
+            job->diagnostics = diagnostics + first;
+            job->passBitmap = passBitmap + first / 8;
+            job->count = count - first < share ? count - first : share;
+            job->validateClues = puzzles->validateClues;
+        }
+        runJobs(jobs, sizeof(CorpusJob), jobCount, runCorpusJob);
+
+        char line[96];
+        for(long i = 0; i < count; i++) {
+            unsigned int diagnostic = diagnostics[i];
+            if(diagnostic == ENTRY_BLANK) continue;
+            stats->checked++;
+            if(diagnostic == 0) continue;
+
+            stats->failed++;
+            stats->malformedPuzzles += (diagnostic & VERIFY_BAD_PUZZLE) != 0;
+            stats->malformedSolutions += (diagnostic & VERIFY_BAD_SOLUTION) != 0;
+            stats->badRows += ((diagnostic >> VERIFY_ROW_SHIFT) & VERIFY_UNIT_MASK) != 0;
+            stats->badColumns += ((diagnostic >> VERIFY_COLUMN_SHIFT) & VERIFY_UNIT_MASK) != 0;
+            stats->badBlocks += ((diagnostic >> VERIFY_BLOCK_SHIFT) & VERIFY_UNIT_MASK) != 0;
+            stats->changedClues += (diagnostic & VERIFY_CLUE_MISMATCH) != 0;
+
+            if(report) {
+                int length = formatVerifyFailure(stats->lines + i + 1, diagnostic, line, sizeof(line));
+                writeText(report, line, (size_t)length);
+            }
+        }
+        if(bitmap) writeText(bitmap, (const char*)passBitmap, (size_t)(count + 7) / 8);
+        stats->lines += count;
+    }
+
+    // Whatever is left in the longer file has nothing to be checked against
+    while(puzzlesLeft && nextRawLine(puzzles)) stats->surplusPuzzles += lineHasContent(puzzles);
+    while(solutionsLeft && nextRawLine(solutions)) stats->surplusSolutions += lineHasContent(solutions);
+
+    stats->seconds = wallTimeSeconds() - start;
+    free(pairs);
+    free(diagnostics);
+    free(passBitmap);
+    return 1;
+}
@@ -0,0 +1,16 @@
+#ifndef VERIFIER_H
+#define VERIFIER_H
+
+#include "sudoku.h"
+
+// Bulk solution verification - clue consistency and all 27 units per solution
+unsigned int verifySolution(const CompactPuzzle* puzzle, const CompactPuzzle* solution);
+long verifySolutions(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                     unsigned int* diagnostics, unsigned char* passBitmap);
+long verifyInParallel(const CompactPuzzle* puzzles, const CompactPuzzle* solutions, long count,
+                      unsigned int* diagnostics, unsigned char* passBitmap, int threads);
+int verifyCorpora(PuzzleCorpus* puzzles, PuzzleCorpus* solutions, int threads,
+                  ResultWriter* report, ResultWriter* bitmap, VerifyStats* stats);
+int formatVerifyFailure(long line, unsigned int diagnostic, char* text, size_t size);
+
+#endif